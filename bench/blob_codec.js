@@ -0,0 +1,89 @@
+// Compares stored (and thus transferred) bytes and end to end latency of blob updates and gets with and without the
+// client side codec. Needs a running cluster:
+//
+//  QDB_URI=qdb://127.0.0.1:2836 node bench/blob_codec.js
+//
+// The payload is JSON, the typical content the codec is meant for.
+
+var qdb = require('..');
+
+var uri = process.env.QDB_URI || 'qdb://127.0.0.1:2836';
+var blobs = 200;
+var itemsPerBlob = 2000;
+
+function makePayload(seed) {
+    var items = new Array(itemsPerBlob);
+    for (var i = 0; i < itemsPerBlob; i++) {
+        items[i] = {
+            id: seed * itemsPerBlob + i,
+            name: 'sensor-' + (i % 97),
+            unit: 'celsius',
+            value: (i * 7919) % 1000 / 10
+        };
+    }
+    return Buffer.from(JSON.stringify(items));
+}
+
+// runs op on every blob one after the other, calls done with the mean latency in microseconds
+function sequence(op, done) {
+    var i = 0;
+    var elapsed = 0n;
+
+    var next = function () {
+        if (i == blobs) return done(Number(elapsed) / blobs / 1000);
+
+        var start = process.hrtime.bigint();
+        op(i++, function (err) {
+            if (err) throw err;
+            elapsed += process.hrtime.bigint() - start;
+            next();
+        });
+    };
+
+    next();
+}
+
+function run(cluster, name, codec, payloads, done) {
+    var blob = function (i) {
+        var b = cluster.blob('bench_codec_' + i);
+        b.setCompression(codec);
+        return b;
+    };
+
+    sequence(function (i, cb) { blob(i).update(payloads[i], cb); }, function (updateUs) {
+        sequence(function (i, cb) { blob(i).get(cb); }, function (getUs) {
+            var stored = 0;
+            var raw = 0;
+
+            sequence(function (i, cb) {
+                raw += payloads[i].length;
+                blob(i).getMetadata(function (err, meta) {
+                    stored += meta.size;
+                    cb(err);
+                });
+            }, function () {
+                console.log(name.padEnd(10) + (stored / blobs / 1024).toFixed(1).padStart(10) + ' KiB/blob stored '
+                    + (raw / stored).toFixed(2).padStart(6) + 'x ' + updateUs.toFixed(0).padStart(8) + ' us/update '
+                    + getUs.toFixed(0).padStart(8) + ' us/get');
+                done();
+            });
+        });
+    });
+}
+
+var cluster = new qdb.Cluster(uri);
+cluster.connect(function () {
+    var payloads = [];
+    for (var i = 0; i < blobs; i++) payloads.push(makePayload(i));
+
+    run(cluster, 'none', qdb.COMPRESSION_NONE, payloads, function () {
+        run(cluster, 'deflate', qdb.COMPRESSION_DEFLATE, payloads, function () {
+            sequence(function (i, cb) { cluster.blob('bench_codec_' + i).remove(cb); }, function () {
+                process.exit(0);
+            });
+        });
+    });
+}, function (err) {
+    console.error('cannot connect to ' + uri + ': ' + err.message);
+    process.exit(1);
+});
@@ -0,0 +1,75 @@
+// Measures the main thread cost of small (10 points) inserts, which is mostly spent converting the JS arguments.
+// Needs a running cluster:
+//
+//  QDB_URI=qdb://127.0.0.1:2836 node bench/insert_small.js
+//
+// The time reported is the time spent in the insert calls themselves, the inserts run on the libuv thread pool and
+// are waited for between rounds so that they do not pile up.
+
+var qdb = require('..');
+
+var uri = process.env.QDB_URI || 'qdb://127.0.0.1:2836';
+var pointsPerInsert = 10;
+var insertsPerRound = 1000;
+var rounds = 50;
+
+function makePoints(round) {
+    var points = new Array(pointsPerInsert);
+    for (var i = 0; i < pointsPerInsert; i++) {
+        points[i] = qdb.DoublePoint(qdb.Timestamp.fromDate(new Date(2049, 0, 1, 0, round, i)), i * 0.5);
+    }
+    return points;
+}
+
+function run(name, insert, done) {
+    var elapsed = 0n;
+    var round = 0;
+
+    var nextRound = function () {
+        if (round == rounds) {
+            var inserts = rounds * insertsPerRound;
+            var ns = Number(elapsed) / inserts;
+            console.log(name.padEnd(16) + (ns / 1000).toFixed(2).padStart(10) + ' us/insert '
+                + (1e9 / ns).toFixed(0).padStart(10) + ' inserts/s (main thread)');
+            return done();
+        }
+
+        var points = makePoints(round++);
+        var pending = insertsPerRound;
+        var callback = function (err) {
+            if (err) throw err;
+            if (--pending == 0) nextRound();
+        };
+
+        var start = process.hrtime.bigint();
+        for (var i = 0; i < insertsPerRound; i++) {
+            insert(points, callback);
+        }
+        elapsed += process.hrtime.bigint() - start;
+    };
+
+    nextRound();
+}
+
+var cluster = new qdb.Cluster(uri);
+cluster.connect(function () {
+    var ts = cluster.ts('bench_insert_small');
+
+    ts.remove(function () {
+        ts.create([qdb.DoubleColumnInfo('value')], function (err, columns) {
+            if (err) throw err;
+
+            var column = columns[0];
+
+            // warm up
+            run('warmup', function (points, cb) { column.insert(points, cb); }, function () {
+                run('column.insert', function (points, cb) { column.insert(points, cb); }, function () {
+                    ts.remove(function () { process.exit(0); });
+                });
+            });
+        });
+    });
+}, function (err) {
+    console.error('cannot connect to ' + uri + ': ' + err.message);
+    process.exit(1);
+});
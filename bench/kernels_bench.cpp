@@ -0,0 +1,126 @@
+// Standalone benchmark of the time series kernels, does not need node nor a running cluster.
+//
+//  c++ -O2 -std=c++14 -Iqdb/include bench/kernels_bench.cpp src/ts_kernels.cpp -o build/kernels_bench
+//  build/kernels_bench
+//
+// To benchmark the AVX2 code paths, as built with enable_avx2, only the AVX2 loops get -mavx2:
+//
+//  c++ -O2 -std=c++14 -mavx2 -DQDB_KERNELS_AVX2 -Iqdb/include -c src/ts_kernels_avx2.cpp -o build/ts_kernels_avx2.o
+//  c++ -O2 -std=c++14 -DQDB_KERNELS_AVX2 -Iqdb/include bench/kernels_bench.cpp src/ts_kernels.cpp \
+//      build/ts_kernels_avx2.o -o build/kernels_bench
+
+#include "../src/ts_kernels.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace quasardb;
+
+namespace
+{
+
+std::vector<qdb_ts_double_point> make_points(size_t count)
+{
+    std::mt19937_64 gen(42);
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    std::vector<qdb_ts_double_point> points(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        points[i].timestamp.tv_sec = static_cast<qdb_time_t>(1500000000 + i / 1000);
+        points[i].timestamp.tv_nsec = static_cast<qdb_time_t>((i % 1000) * 1000000);
+        points[i].value = 100.0 * std::sin(static_cast<double>(i) * 1e-4) + noise(gen);
+    }
+
+    return points;
+}
+
+template <typename F>
+double best_of(int runs, F f)
+{
+    double best = 1e300;
+    for (int r = 0; r < runs; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+
+    return best;
+}
+
+void report(const char * name, size_t count, double ms)
+{
+    std::printf("%-24s %10zu points %10.3f ms %10.1f Mpoints/s\n", name, count, ms,
+        static_cast<double>(count) / (ms * 1000.0));
+}
+
+kernel_spec make_spec(kernel_op op, double param = 0.0, size_t buckets = 0)
+{
+    kernel_spec spec;
+    spec.op = op;
+    spec.param = param;
+    spec.buckets = buckets;
+    return spec;
+}
+
+} // namespace
+
+int main()
+{
+    const int runs = 5;
+    std::printf("kernels built with %s code paths, best of %d runs\n", kernel_simd_flavour(), runs);
+
+    for (size_t count : {size_t(1000000), size_t(10000000)})
+    {
+        const auto points = make_points(count);
+
+        kernel_input input;
+        report("gather", count, best_of(runs, [&] { gather_points(points.data(), points.size(), input); }));
+
+        volatile double sink = 0.0;
+
+        report("minmax", count,
+            best_of(runs,
+                [&]
+                {
+                    double min, max;
+                    kernel_minmax(input.values.data(), input.values.size(), min, max);
+                    sink = min + max;
+                }));
+
+        std::vector<qdb_uint_t> counts(64);
+        report("histogram(64, bounded)", count,
+            best_of(runs,
+                [&]
+                {
+                    std::fill(counts.begin(), counts.end(), 0);
+                    kernel_histogram(
+                        input.values.data(), input.values.size(), -50.0, 50.0, counts.size(), counts.data());
+                }));
+
+        const struct
+        {
+            const char * name;
+            kernel_spec spec;
+        } kernels[] = {
+            {"percentile(99)", make_spec(kernel_op::percentile, 99.0)},
+            {"ewma(0.1)", make_spec(kernel_op::ewma, 0.1)},
+            {"rate", make_spec(kernel_op::rate)},
+            {"histogram(64)", make_spec(kernel_op::histogram, 0.0, 64)},
+        };
+
+        for (const auto & k : kernels)
+        {
+            report(k.name, count, best_of(runs, [&] { sink = compute_kernel(input, k.spec).value; }));
+        }
+
+        (void)sink;
+        std::printf("\n");
+    }
+
+    return 0;
+}
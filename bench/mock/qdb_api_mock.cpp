@@ -0,0 +1,1068 @@
+// Stand-in for libqdb_api, built from the headers of the C API, so that the addon can be benchmarked without a
+// cluster. Build the addon with --mock_c_api=yes to link it against this library, see bench/run.js.
+//
+// Blobs, integers and tags are kept in memory, in a single store shared by every handle. Time series only keep their
+// columns: inserts check their points and drop them, ranges return one synthetic point per second of every range.
+// Queries return synthetic rows, as many as the limit of the query. Nothing goes through the network, what is measured
+// is the addon.
+
+#include <qdb/batch.h>
+#include <qdb/blob.h>
+#include <qdb/client.h>
+#include <qdb/integer.h>
+#include <qdb/prefix.h>
+#include <qdb/query.h>
+#include <qdb/suffix.h>
+#include <qdb/tag.h>
+#include <qdb/ts.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct qdb_handle_internal
+{
+    bool connected = false;
+};
+
+namespace
+{
+
+// a range, or a query, returns at most that many points, to keep mistakes in the benchmarks from exhausting memory
+const size_t max_points = size_t(1) << 24;
+const size_t default_query_rows = 1000;
+
+const char synthetic_blob[] = "synthetic blob content";
+const char synthetic_string[] = "synthetic string";
+const char * const synthetic_symbols[] = {"AAPL", "GOOG", "MSFT", "NVDA"};
+
+// Memory handed out to the addon, kept until it is given back with qdb_release.
+struct allocation
+{
+    virtual ~allocation()
+    {
+    }
+};
+
+template <typename T>
+struct owned : allocation
+{
+    T value;
+};
+
+std::mutex allocations_mutex;
+std::unordered_map<const void *, std::unique_ptr<allocation>> allocations;
+
+// Keeps a until the address is released. Empty results are handed out as null pointers, which need no release.
+template <typename T, typename Address>
+Address * hand_out(std::unique_ptr<owned<T>> a, Address * address)
+{
+    if (!address) return nullptr;
+
+    std::lock_guard<std::mutex> lock(allocations_mutex);
+    allocations[address] = std::move(a);
+    return address;
+}
+
+struct string_array
+{
+    std::vector<std::string> strings;
+    std::vector<const char *> pointers;
+};
+
+const char ** hand_out_strings(std::vector<std::string> strings)
+{
+    std::unique_ptr<owned<string_array>> a(new owned<string_array>());
+    a->value.strings = std::move(strings);
+    for (const auto & s : a->value.strings)
+    {
+        a->value.pointers.push_back(s.c_str());
+    }
+
+    const char ** address = a->value.pointers.empty() ? nullptr : a->value.pointers.data();
+    return hand_out(std::move(a), address);
+}
+
+const void * hand_out_copy(const void * content, size_t size)
+{
+    std::unique_ptr<owned<std::vector<char>>> a(new owned<std::vector<char>>());
+    a->value.assign(static_cast<const char *>(content), static_cast<const char *>(content) + size);
+
+    // an empty content still needs an address of its own
+    a->value.reserve(1);
+    const void * address = a->value.data();
+    return hand_out(std::move(a), address);
+}
+
+struct column
+{
+    std::string name;
+    qdb_ts_column_type_t type;
+    std::string symtable;
+};
+
+struct entry
+{
+    qdb_entry_type_t type;
+    std::string content;
+    qdb_int_t value = 0;
+    qdb_time_t expiry = qdb_never_expires;
+    qdb_timespec_t modification_time{0, 0};
+    std::vector<column> columns;
+};
+
+// the whole content of the mock cluster, ordered for prefix lookups
+std::mutex store_mutex;
+std::map<std::string, entry> entries;
+std::map<std::string, std::set<std::string>> tagged;
+
+using lock = std::lock_guard<std::mutex>;
+
+qdb_timespec_t now()
+{
+    const auto ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    return qdb_timespec_t{static_cast<qdb_time_t>(ns / 1000000000), static_cast<qdb_time_t>(ns % 1000000000)};
+}
+
+entry * find(const char * alias)
+{
+    auto it = entries.find(alias);
+    return (it == entries.end()) ? nullptr : &it->second;
+}
+
+qdb_error_t find(const char * alias, qdb_entry_type_t type, entry ** e)
+{
+    *e = find(alias);
+    if (!*e) return qdb_e_alias_not_found;
+    return ((*e)->type == type) ? qdb_e_ok : qdb_e_incompatible_type;
+}
+
+void set_content(entry & e, const void * content, qdb_size_t size, qdb_time_t expiry)
+{
+    e.content.assign(static_cast<const char *>(content), size);
+    if (expiry != qdb_preserve_expiration) e.expiry = expiry;
+    e.modification_time = now();
+}
+
+qdb_error_t lookup(bool suffix, const char * key, qdb_int_t max_count, const char *** results, size_t * count)
+{
+    const std::string k = key;
+    std::vector<std::string> aliases;
+
+    {
+        lock l(store_mutex);
+        for (const auto & e : entries)
+        {
+            if (static_cast<qdb_int_t>(aliases.size()) >= max_count) break;
+
+            const std::string & alias = e.first;
+            if (alias.size() < k.size()) continue;
+            if (alias.compare(suffix ? alias.size() - k.size() : 0, k.size(), k) == 0) aliases.push_back(alias);
+        }
+    }
+
+    *count = aliases.size();
+    *results = hand_out_strings(std::move(aliases));
+    return *count ? qdb_e_ok : qdb_e_alias_not_found;
+}
+
+qdb_error_t column_of(const char * alias, const char * column_name, qdb_ts_column_type_t type)
+{
+    entry * e = nullptr;
+    const qdb_error_t err = find(alias, qdb_entry_ts, &e);
+    if (err != qdb_e_ok) return err;
+
+    for (const auto & c : e->columns)
+    {
+        if (c.name != column_name) continue;
+
+        // symbol columns are read and written as strings
+        return ((c.type == type) || ((c.type == qdb_ts_column_symbol) && (type == qdb_ts_column_string)))
+                   ? qdb_e_ok
+                   : qdb_e_incompatible_type;
+    }
+
+    return qdb_e_column_not_found;
+}
+
+template <typename Point>
+qdb_error_t insert(
+    const char * alias, const char * column_name, qdb_ts_column_type_t type, const Point * points, qdb_size_t count)
+{
+    if (!points && count) return qdb_e_invalid_argument;
+
+    lock l(store_mutex);
+    return column_of(alias, column_name, type);
+}
+
+size_t points_in(const qdb_ts_range_t & range)
+{
+    if (range.end.tv_sec <= range.begin.tv_sec) return 0;
+    return static_cast<size_t>(range.end.tv_sec - range.begin.tv_sec);
+}
+
+void fill(qdb_ts_double_point & p, size_t i)
+{
+    p.value = static_cast<double>(i) * 0.5;
+}
+
+void fill(qdb_ts_int64_point & p, size_t i)
+{
+    p.value = static_cast<qdb_int_t>(i);
+}
+
+void fill(qdb_ts_timestamp_point & p, size_t)
+{
+    p.value = p.timestamp;
+}
+
+void fill(qdb_ts_blob_point & p, size_t)
+{
+    p.content = synthetic_blob;
+    p.content_length = sizeof(synthetic_blob) - 1;
+}
+
+// strings and symbols, whether the headers make them the same type or not
+template <typename Point>
+void fill(Point & p, size_t i)
+{
+    p.content = synthetic_symbols[i % (sizeof(synthetic_symbols) / sizeof(synthetic_symbols[0]))];
+    p.content_length = std::strlen(p.content);
+}
+
+template <typename Point>
+qdb_error_t get_ranges(const char * alias,
+    const char * column_name,
+    qdb_ts_column_type_t type,
+    const qdb_ts_range_t * ranges,
+    qdb_size_t range_count,
+    Point ** points,
+    qdb_size_t * count)
+{
+    {
+        lock l(store_mutex);
+        const qdb_error_t err = column_of(alias, column_name, type);
+        if (err != qdb_e_ok) return err;
+    }
+
+    std::unique_ptr<owned<std::vector<Point>>> a(new owned<std::vector<Point>>());
+    auto & result = a->value;
+
+    for (qdb_size_t r = 0; r < range_count; ++r)
+    {
+        const size_t n = std::min(points_in(ranges[r]), max_points - result.size());
+        for (size_t i = 0; i < n; ++i)
+        {
+            Point p;
+            p.timestamp = qdb_timespec_t{ranges[r].begin.tv_sec + static_cast<qdb_time_t>(i), ranges[r].begin.tv_nsec};
+            fill(p, result.size());
+            result.push_back(p);
+        }
+    }
+
+    *count = result.size();
+    *points = hand_out(std::move(a), result.empty() ? nullptr : result.data());
+    return qdb_e_ok;
+}
+
+template <typename Aggregation>
+void set_content(Aggregation & a)
+{
+    // the addon releases the content of the blob and string aggregation results
+    a.result.content = static_cast<const char *>(hand_out_copy(a.result.content, a.result.content_length));
+}
+
+void set_content(qdb_ts_double_aggregation_t &)
+{
+}
+
+void set_content(qdb_ts_int64_aggregation_t &)
+{
+}
+
+void set_content(qdb_ts_timestamp_aggregation_t &)
+{
+}
+
+// Aggregates the synthetic points as they would be returned by the ranges: the count of points and the first one.
+template <typename Aggregation>
+qdb_error_t aggregate(const char * alias,
+    const char * column_name,
+    qdb_ts_column_type_t type,
+    Aggregation * aggregations,
+    qdb_size_t count)
+{
+    {
+        lock l(store_mutex);
+        const qdb_error_t err = column_of(alias, column_name, type);
+        if (err != qdb_e_ok) return err;
+    }
+
+    for (qdb_size_t i = 0; i < count; ++i)
+    {
+        auto & a = aggregations[i];
+        a.count = points_in(a.range);
+        a.result.timestamp = a.range.begin;
+        fill(a.result, 0);
+        set_content(a);
+    }
+
+    return qdb_e_ok;
+}
+
+struct query_table
+{
+    std::vector<std::string> names;
+    std::vector<qdb_string_t> column_names;
+    std::vector<qdb_point_result_t> cells;
+    std::vector<qdb_point_result_t *> rows;
+    qdb_query_result_t result;
+};
+
+// the row count asked for by the limit of the query
+size_t query_rows(const char * query)
+{
+    static const std::regex limit("\\blimit\\s+(\\d+)", std::regex::icase);
+
+    std::cmatch match;
+    if (!std::regex_search(query, match, limit)) return default_query_rows;
+
+    return std::min(static_cast<size_t>(std::stoull(match[1].str())), max_points);
+}
+
+} // namespace
+
+extern "C"
+{
+
+qdb_handle_t qdb_open_tcp(void)
+{
+    return new qdb_handle_internal();
+}
+
+qdb_error_t qdb_close(qdb_handle_t handle)
+{
+    delete handle;
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_connect(qdb_handle_t handle, const char * uri)
+{
+    if (!handle) return qdb_e_invalid_handle;
+    if (!uri) return qdb_e_invalid_argument;
+
+    handle->connected = true;
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_option_set_timeout(qdb_handle_t handle, int)
+{
+    return handle ? qdb_e_ok : qdb_e_invalid_handle;
+}
+
+qdb_error_t qdb_option_load_security_files(qdb_handle_t handle, const char *, const char *)
+{
+    return handle ? qdb_e_ok : qdb_e_invalid_handle;
+}
+
+void qdb_release(qdb_handle_t, const void * buffer)
+{
+    if (!buffer) return;
+
+    std::unique_ptr<allocation> a;
+
+    {
+        std::lock_guard<std::mutex> l(allocations_mutex);
+        auto it = allocations.find(buffer);
+        if (it == allocations.end()) return;
+
+        a = std::move(it->second);
+        allocations.erase(it);
+    }
+}
+
+const char * qdb_error(qdb_error_t error)
+{
+    switch (error)
+    {
+    case qdb_e_ok:
+        return "Success.";
+    case qdb_e_alias_not_found:
+        return "An entry matching the provided alias cannot be found.";
+    case qdb_e_alias_already_exists:
+        return "An entry matching the provided alias already exists.";
+    case qdb_e_incompatible_type:
+        return "The alias has a type incompatible for this operation.";
+    case qdb_e_unmatched_content:
+        return "The content did not match.";
+    case qdb_e_tag_already_set:
+        return "The entry already has the provided tag.";
+    case qdb_e_tag_not_set:
+        return "The entry does not have the provided tag.";
+    case qdb_e_column_not_found:
+        return "A column with the provided name cannot be found.";
+    case qdb_e_invalid_argument:
+        return "The argument is invalid.";
+    case qdb_e_not_implemented:
+        return "The requested operation is not implemented by the mock C API.";
+    case qdb_e_ok_created:
+        return "Successful creation.";
+    default:
+        return "An error occured.";
+    }
+}
+
+qdb_error_t qdb_remove(qdb_handle_t, const char * alias)
+{
+    lock l(store_mutex);
+    if (!entries.erase(alias)) return qdb_e_alias_not_found;
+
+    for (auto & t : tagged)
+    {
+        t.second.erase(alias);
+    }
+
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_expires_at(qdb_handle_t, const char * alias, qdb_time_t expiry_time)
+{
+    lock l(store_mutex);
+    entry * e = find(alias);
+    if (!e) return qdb_e_alias_not_found;
+    if ((e->type != qdb_entry_blob) && (e->type != qdb_entry_integer)) return qdb_e_incompatible_type;
+
+    e->expiry = expiry_time;
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_expires_from_now(qdb_handle_t handle, const char * alias, qdb_time_t expiry_delta)
+{
+    const qdb_timespec_t t = now();
+    return qdb_expires_at(handle, alias, t.tv_sec * 1000 + t.tv_nsec / 1000000 + expiry_delta);
+}
+
+qdb_error_t qdb_get_metadata(qdb_handle_t, const char * alias, qdb_entry_metadata_t * metadata)
+{
+    lock l(store_mutex);
+    entry * e = find(alias);
+    if (!e) return qdb_e_alias_not_found;
+
+    std::memset(metadata, 0, sizeof(*metadata));
+    metadata->type = e->type;
+    metadata->size = e->content.size();
+    metadata->modification_time = e->modification_time;
+    metadata->expiry_time = qdb_timespec_t{e->expiry / 1000, (e->expiry % 1000) * 1000000};
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_attach_tag(qdb_handle_t, const char * alias, const char * tag)
+{
+    lock l(store_mutex);
+    if (!find(alias)) return qdb_e_alias_not_found;
+
+    return tagged[tag].insert(alias).second ? qdb_e_ok : qdb_e_tag_already_set;
+}
+
+qdb_error_t qdb_attach_tags(qdb_handle_t handle, const char * alias, const char * const * tags, size_t tag_count)
+{
+    for (size_t i = 0; i < tag_count; ++i)
+    {
+        const qdb_error_t err = qdb_attach_tag(handle, alias, tags[i]);
+        if ((err != qdb_e_ok) && (err != qdb_e_tag_already_set)) return err;
+    }
+
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_detach_tag(qdb_handle_t, const char * alias, const char * tag)
+{
+    lock l(store_mutex);
+    if (!find(alias)) return qdb_e_alias_not_found;
+
+    auto it = tagged.find(tag);
+    return ((it != tagged.end()) && it->second.erase(alias)) ? qdb_e_ok : qdb_e_tag_not_set;
+}
+
+qdb_error_t qdb_detach_tags(qdb_handle_t handle, const char * alias, const char * const * tags, size_t tag_count)
+{
+    for (size_t i = 0; i < tag_count; ++i)
+    {
+        const qdb_error_t err = qdb_detach_tag(handle, alias, tags[i]);
+        if ((err != qdb_e_ok) && (err != qdb_e_tag_not_set)) return err;
+    }
+
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_has_tag(qdb_handle_t, const char * alias, const char * tag)
+{
+    lock l(store_mutex);
+    if (!find(alias)) return qdb_e_alias_not_found;
+
+    auto it = tagged.find(tag);
+    return ((it != tagged.end()) && it->second.count(alias)) ? qdb_e_ok : qdb_e_tag_not_set;
+}
+
+qdb_error_t qdb_get_tags(qdb_handle_t, const char * alias, const char *** tags, size_t * tag_count)
+{
+    std::vector<std::string> result;
+
+    {
+        lock l(store_mutex);
+        if (!find(alias)) return qdb_e_alias_not_found;
+
+        for (const auto & t : tagged)
+        {
+            if (t.second.count(alias)) result.push_back(t.first);
+        }
+    }
+
+    *tag_count = result.size();
+    *tags = hand_out_strings(std::move(result));
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_get_tagged(qdb_handle_t, const char * tag, const char *** aliases, size_t * alias_count)
+{
+    std::vector<std::string> result;
+
+    {
+        lock l(store_mutex);
+        auto it = tagged.find(tag);
+        if ((it == tagged.end()) || it->second.empty()) return qdb_e_alias_not_found;
+
+        result.assign(it->second.begin(), it->second.end());
+    }
+
+    *alias_count = result.size();
+    *aliases = hand_out_strings(std::move(result));
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_get_tagged_count(qdb_handle_t, const char * tag, qdb_uint_t * count)
+{
+    lock l(store_mutex);
+    auto it = tagged.find(tag);
+    *count = (it == tagged.end()) ? 0 : it->second.size();
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_prefix_get(
+    qdb_handle_t, const char * prefix, qdb_int_t max_count, const char *** results, size_t * result_count)
+{
+    return lookup(false, prefix, max_count, results, result_count);
+}
+
+qdb_error_t qdb_prefix_count(qdb_handle_t handle, const char * prefix, qdb_uint_t * result_count)
+{
+    const char ** results = nullptr;
+    size_t count = 0;
+
+    const qdb_error_t err = lookup(false, prefix, std::numeric_limits<qdb_int_t>::max(), &results, &count);
+    qdb_release(handle, results);
+
+    *result_count = count;
+    return (err == qdb_e_alias_not_found) ? qdb_e_ok : err;
+}
+
+qdb_error_t qdb_suffix_get(
+    qdb_handle_t, const char * suffix, qdb_int_t max_count, const char *** results, size_t * result_count)
+{
+    return lookup(true, suffix, max_count, results, result_count);
+}
+
+qdb_error_t qdb_suffix_count(qdb_handle_t handle, const char * suffix, qdb_uint_t * result_count)
+{
+    const char ** results = nullptr;
+    size_t count = 0;
+
+    const qdb_error_t err = lookup(true, suffix, std::numeric_limits<qdb_int_t>::max(), &results, &count);
+    qdb_release(handle, results);
+
+    *result_count = count;
+    return (err == qdb_e_alias_not_found) ? qdb_e_ok : err;
+}
+
+qdb_error_t qdb_blob_put(
+    qdb_handle_t, const char * alias, const void * content, qdb_size_t content_length, qdb_time_t expiry_time)
+{
+    lock l(store_mutex);
+    if (find(alias)) return qdb_e_alias_already_exists;
+
+    entry & e = entries[alias];
+    e.type = qdb_entry_blob;
+    set_content(e, content, content_length, expiry_time);
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_blob_update(
+    qdb_handle_t, const char * alias, const void * content, qdb_size_t content_length, qdb_time_t expiry_time)
+{
+    lock l(store_mutex);
+    entry * e = find(alias);
+    if (e && (e->type != qdb_entry_blob)) return qdb_e_incompatible_type;
+
+    const bool created = !e;
+    if (created)
+    {
+        e = &entries[alias];
+        e->type = qdb_entry_blob;
+    }
+
+    set_content(*e, content, content_length, expiry_time);
+    return created ? qdb_e_ok_created : qdb_e_ok;
+}
+
+qdb_error_t qdb_blob_get(qdb_handle_t, const char * alias, const void ** content, qdb_size_t * content_length)
+{
+    lock l(store_mutex);
+    entry * e = nullptr;
+    const qdb_error_t err = find(alias, qdb_entry_blob, &e);
+    if (err != qdb_e_ok) return err;
+
+    *content_length = e->content.size();
+    *content = hand_out_copy(e->content.data(), e->content.size());
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_blob_get_noalloc(qdb_handle_t, const char * alias, void * content, qdb_size_t * content_length)
+{
+    lock l(store_mutex);
+    entry * e = nullptr;
+    const qdb_error_t err = find(alias, qdb_entry_blob, &e);
+    if (err != qdb_e_ok) return err;
+
+    const qdb_size_t capacity = *content_length;
+    *content_length = e->content.size();
+    if (capacity < e->content.size()) return qdb_e_buffer_too_small;
+
+    std::memcpy(content, e->content.data(), e->content.size());
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_blob_get_and_remove(
+    qdb_handle_t handle, const char * alias, const void ** content, qdb_size_t * content_length)
+{
+    const qdb_error_t err = qdb_blob_get(handle, alias, content, content_length);
+    if (err != qdb_e_ok) return err;
+
+    return qdb_remove(handle, alias);
+}
+
+qdb_error_t qdb_blob_get_and_update(qdb_handle_t,
+    const char * alias,
+    const void * update_content,
+    qdb_size_t update_content_length,
+    qdb_time_t expiry_time,
+    const void ** get_content,
+    qdb_size_t * get_content_length)
+{
+    lock l(store_mutex);
+    entry * e = nullptr;
+    const qdb_error_t err = find(alias, qdb_entry_blob, &e);
+    if (err != qdb_e_ok) return err;
+
+    *get_content_length = e->content.size();
+    *get_content = hand_out_copy(e->content.data(), e->content.size());
+    set_content(*e, update_content, update_content_length, expiry_time);
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_blob_compare_and_swap(qdb_handle_t,
+    const char * alias,
+    const void * new_value,
+    qdb_size_t new_value_length,
+    const void * comparand,
+    qdb_size_t comparand_length,
+    qdb_time_t expiry_time,
+    const void ** original_value,
+    qdb_size_t * original_value_length)
+{
+    lock l(store_mutex);
+    entry * e = nullptr;
+    const qdb_error_t err = find(alias, qdb_entry_blob, &e);
+    if (err != qdb_e_ok) return err;
+
+    if (e->content.compare(0, std::string::npos, static_cast<const char *>(comparand), comparand_length) != 0)
+    {
+        *original_value_length = e->content.size();
+        *original_value = hand_out_copy(e->content.data(), e->content.size());
+        return qdb_e_unmatched_content;
+    }
+
+    *original_value = nullptr;
+    *original_value_length = 0;
+    set_content(*e, new_value, new_value_length, expiry_time);
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_blob_remove_if(qdb_handle_t handle, const char * alias, const void * comparand, qdb_size_t length)
+{
+    {
+        lock l(store_mutex);
+        entry * e = nullptr;
+        const qdb_error_t err = find(alias, qdb_entry_blob, &e);
+        if (err != qdb_e_ok) return err;
+
+        if (e->content.compare(0, std::string::npos, static_cast<const char *>(comparand), length) != 0)
+        {
+            return qdb_e_unmatched_content;
+        }
+    }
+
+    return qdb_remove(handle, alias);
+}
+
+qdb_error_t qdb_blob_scan(qdb_handle_t,
+    const void * pattern,
+    qdb_size_t pattern_length,
+    qdb_int_t max_count,
+    const char *** results,
+    size_t * result_count)
+{
+    const std::string p(static_cast<const char *>(pattern), pattern_length);
+    std::vector<std::string> aliases;
+
+    {
+        lock l(store_mutex);
+        for (const auto & e : entries)
+        {
+            if (static_cast<qdb_int_t>(aliases.size()) >= max_count) break;
+            if ((e.second.type == qdb_entry_blob) && (e.second.content.find(p) != std::string::npos))
+            {
+                aliases.push_back(e.first);
+            }
+        }
+    }
+
+    *result_count = aliases.size();
+    *results = hand_out_strings(std::move(aliases));
+    return *result_count ? qdb_e_ok : qdb_e_alias_not_found;
+}
+
+qdb_error_t qdb_blob_scan_regex(
+    qdb_handle_t, const char * pattern, qdb_int_t max_count, const char *** results, size_t * result_count)
+{
+    std::regex re;
+    try
+    {
+        re.assign(pattern);
+    }
+    catch (const std::regex_error &)
+    {
+        return qdb_e_invalid_regex;
+    }
+
+    std::vector<std::string> aliases;
+
+    {
+        lock l(store_mutex);
+        for (const auto & e : entries)
+        {
+            if (static_cast<qdb_int_t>(aliases.size()) >= max_count) break;
+            if ((e.second.type == qdb_entry_blob) && std::regex_search(e.second.content, re))
+            {
+                aliases.push_back(e.first);
+            }
+        }
+    }
+
+    *result_count = aliases.size();
+    *results = hand_out_strings(std::move(aliases));
+    return *result_count ? qdb_e_ok : qdb_e_alias_not_found;
+}
+
+qdb_error_t qdb_int_put(qdb_handle_t, const char * alias, qdb_int_t integer, qdb_time_t expiry_time)
+{
+    lock l(store_mutex);
+    if (find(alias)) return qdb_e_alias_already_exists;
+
+    entry & e = entries[alias];
+    e.type = qdb_entry_integer;
+    e.value = integer;
+    if (expiry_time != qdb_preserve_expiration) e.expiry = expiry_time;
+    e.modification_time = now();
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_int_update(qdb_handle_t, const char * alias, qdb_int_t integer, qdb_time_t expiry_time)
+{
+    lock l(store_mutex);
+    entry * e = find(alias);
+    if (e && (e->type != qdb_entry_integer)) return qdb_e_incompatible_type;
+
+    const bool created = !e;
+    if (created)
+    {
+        e = &entries[alias];
+        e->type = qdb_entry_integer;
+    }
+
+    e->value = integer;
+    if (expiry_time != qdb_preserve_expiration) e->expiry = expiry_time;
+    e->modification_time = now();
+    return created ? qdb_e_ok_created : qdb_e_ok;
+}
+
+qdb_error_t qdb_int_get(qdb_handle_t, const char * alias, qdb_int_t * integer)
+{
+    lock l(store_mutex);
+    entry * e = nullptr;
+    const qdb_error_t err = find(alias, qdb_entry_integer, &e);
+    if (err != qdb_e_ok) return err;
+
+    *integer = e->value;
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_int_add(qdb_handle_t, const char * alias, qdb_int_t addend, qdb_int_t * result)
+{
+    lock l(store_mutex);
+    entry * e = nullptr;
+    const qdb_error_t err = find(alias, qdb_entry_integer, &e);
+    if (err != qdb_e_ok) return err;
+
+    e->value += addend;
+    e->modification_time = now();
+    if (result) *result = e->value;
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_init_operations(qdb_operation_t * operations, size_t operation_count)
+{
+    if (!operations && operation_count) return qdb_e_invalid_argument;
+
+    std::memset(operations, 0, sizeof(qdb_operation_t) * operation_count);
+    for (size_t i = 0; i < operation_count; ++i)
+    {
+        operations[i].type = qdb_op_uninitialized;
+        operations[i].error = qdb_e_uninitialized;
+    }
+
+    return qdb_e_ok;
+}
+
+// only the operations made by the addon are supported, the others fail with qdb_e_not_implemented
+size_t qdb_run_batch(qdb_handle_t handle, qdb_operation_t * operations, size_t operation_count)
+{
+    size_t success_count = 0;
+
+    for (size_t i = 0; i < operation_count; ++i)
+    {
+        qdb_operation_t & op = operations[i];
+        op.error = (op.type == qdb_op_has_tag) ? qdb_has_tag(handle, op.alias, op.has_tag.tag) : qdb_e_not_implemented;
+
+        if (op.error == qdb_e_ok) ++success_count;
+    }
+
+    return success_count;
+}
+
+qdb_error_t qdb_query(qdb_handle_t, const char * query, qdb_query_result_t ** result)
+{
+    if (!query) return qdb_e_invalid_argument;
+
+    std::unique_ptr<owned<query_table>> a(new owned<query_table>());
+    query_table & table = a->value;
+
+    // one column of every scalar type the addon converts
+    table.names = {"$timestamp", "$table", "value", "count", "label"};
+    for (const auto & name : table.names)
+    {
+        table.column_names.push_back(qdb_string_t{name.c_str(), name.size()});
+    }
+
+    const size_t column_count = table.names.size();
+    const size_t row_count = query_rows(query);
+    const qdb_timespec_t start = now();
+
+    table.cells.resize(row_count * column_count);
+    for (size_t i = 0; i < row_count; ++i)
+    {
+        qdb_point_result_t * row = table.cells.data() + i * column_count;
+
+        row[0].type = qdb_query_result_timestamp;
+        row[0].payload.timestamp.value = qdb_timespec_t{start.tv_sec + static_cast<qdb_time_t>(i), 0};
+        row[1].type = qdb_query_result_blob;
+        row[1].payload.blob.content = synthetic_blob;
+        row[1].payload.blob.content_length = sizeof(synthetic_blob) - 1;
+        row[2].type = qdb_query_result_double;
+        row[2].payload.double_.value = static_cast<double>(i) * 0.5;
+        row[3].type = qdb_query_result_int64;
+        row[3].payload.int64_.value = static_cast<qdb_int_t>(i);
+        row[4].type = qdb_query_result_string;
+        row[4].payload.string.content = synthetic_string;
+        row[4].payload.string.content_length = sizeof(synthetic_string) - 1;
+
+        table.rows.push_back(row);
+    }
+
+    table.result.column_names = table.column_names.data();
+    table.result.column_count = column_count;
+    table.result.rows = table.rows.data();
+    table.result.row_count = row_count;
+    table.result.scanned_point_count = row_count * column_count;
+    table.result.error_message = qdb_string_t{"", 0};
+
+    *result = hand_out(std::move(a), &table.result);
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_query_find(qdb_handle_t, const char *, const char *** aliases, size_t * alias_count)
+{
+    std::vector<std::string> result;
+
+    {
+        lock l(store_mutex);
+        for (const auto & e : entries)
+        {
+            result.push_back(e.first);
+        }
+    }
+
+    *alias_count = result.size();
+    *aliases = hand_out_strings(std::move(result));
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_ts_create_ex(
+    qdb_handle_t, const char * alias, qdb_uint_t, const qdb_ts_column_info_ex_t * columns, qdb_size_t column_count)
+{
+    lock l(store_mutex);
+    if (find(alias)) return qdb_e_alias_already_exists;
+
+    entry & e = entries[alias];
+    e.type = qdb_entry_ts;
+    e.modification_time = now();
+    for (qdb_size_t i = 0; i < column_count; ++i)
+    {
+        e.columns.push_back(column{columns[i].name, columns[i].type, columns[i].symtable ? columns[i].symtable : ""});
+    }
+
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_ts_insert_columns_ex(
+    qdb_handle_t, const char * alias, const qdb_ts_column_info_ex_t * columns, qdb_size_t column_count)
+{
+    lock l(store_mutex);
+    entry * e = nullptr;
+    const qdb_error_t err = find(alias, qdb_entry_ts, &e);
+    if (err != qdb_e_ok) return err;
+
+    for (qdb_size_t i = 0; i < column_count; ++i)
+    {
+        const bool exists = std::any_of(e->columns.cbegin(), e->columns.cend(),
+            [&](const column & c) { return c.name == columns[i].name; });
+        if (exists) return qdb_e_element_already_exists;
+    }
+
+    for (qdb_size_t i = 0; i < column_count; ++i)
+    {
+        e->columns.push_back(column{columns[i].name, columns[i].type, columns[i].symtable ? columns[i].symtable : ""});
+    }
+
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_ts_list_columns_ex(
+    qdb_handle_t, const char * alias, qdb_ts_column_info_ex_t ** columns, qdb_size_t * column_count)
+{
+    struct column_list
+    {
+        std::vector<column> columns;
+        std::vector<qdb_ts_column_info_ex_t> infos;
+    };
+
+    std::unique_ptr<owned<column_list>> a(new owned<column_list>());
+
+    {
+        lock l(store_mutex);
+        entry * e = nullptr;
+        const qdb_error_t err = find(alias, qdb_entry_ts, &e);
+        if (err != qdb_e_ok) return err;
+
+        a->value.columns = e->columns;
+    }
+
+    for (const auto & c : a->value.columns)
+    {
+        qdb_ts_column_info_ex_t info;
+        std::memset(&info, 0, sizeof(info));
+        info.name = c.name.c_str();
+        info.type = c.type;
+        info.symtable = c.symtable.c_str();
+        a->value.infos.push_back(info);
+    }
+
+    qdb_ts_column_info_ex_t * infos = a->value.infos.empty() ? nullptr : a->value.infos.data();
+    *column_count = a->value.infos.size();
+    *columns = hand_out(std::move(a), infos);
+    return qdb_e_ok;
+}
+
+qdb_error_t qdb_ts_erase_ranges(qdb_handle_t,
+    const char * alias,
+    const char * column_name,
+    const qdb_ts_range_t * ranges,
+    qdb_size_t range_count,
+    qdb_uint_t * erased_count)
+{
+    lock l(store_mutex);
+    entry * e = nullptr;
+    const qdb_error_t err = find(alias, qdb_entry_ts, &e);
+    if (err != qdb_e_ok) return err;
+
+    const bool exists = std::any_of(
+        e->columns.cbegin(), e->columns.cend(), [&](const column & c) { return c.name == column_name; });
+    if (!exists) return qdb_e_column_not_found;
+
+    // nothing is stored, the synthetic points cannot be erased
+    (void)ranges;
+    (void)range_count;
+    *erased_count = 0;
+    return qdb_e_ok;
+}
+
+// clang-format off
+#define QDB_MOCK_TS_FUNCTIONS(name, column_type, point, aggregation)                                                   \
+    qdb_error_t qdb_ts_##name##_insert(                                                                                \
+        qdb_handle_t, const char * alias, const char * column, const point * values, qdb_size_t count)                 \
+    {                                                                                                                  \
+        return insert(alias, column, column_type, values, count);                                                      \
+    }                                                                                                                  \
+                                                                                                                       \
+    qdb_error_t qdb_ts_##name##_get_ranges(qdb_handle_t, const char * alias, const char * column,                     \
+        const qdb_ts_range_t * ranges, qdb_size_t range_count, point ** points, qdb_size_t * point_count)              \
+    {                                                                                                                  \
+        return get_ranges(alias, column, column_type, ranges, range_count, points, point_count);                       \
+    }                                                                                                                  \
+                                                                                                                       \
+    qdb_error_t qdb_ts_##name##_aggregate(                                                                             \
+        qdb_handle_t, const char * alias, const char * column, aggregation * aggregations, qdb_size_t count)           \
+    {                                                                                                                  \
+        return aggregate(alias, column, column_type, aggregations, count);                                             \
+    }
+// clang-format on
+
+QDB_MOCK_TS_FUNCTIONS(double, qdb_ts_column_double, qdb_ts_double_point, qdb_ts_double_aggregation_t)
+QDB_MOCK_TS_FUNCTIONS(blob, qdb_ts_column_blob, qdb_ts_blob_point, qdb_ts_blob_aggregation_t)
+QDB_MOCK_TS_FUNCTIONS(string, qdb_ts_column_string, qdb_ts_string_point, qdb_ts_string_aggregation_t)
+QDB_MOCK_TS_FUNCTIONS(symbol, qdb_ts_column_symbol, qdb_ts_symbol_point, qdb_ts_symbol_aggregation_t)
+QDB_MOCK_TS_FUNCTIONS(int64, qdb_ts_column_int64, qdb_ts_int64_point, qdb_ts_int64_aggregation_t)
+QDB_MOCK_TS_FUNCTIONS(timestamp, qdb_ts_column_timestamp, qdb_ts_timestamp_point, qdb_ts_timestamp_aggregation_t)
+
+#undef QDB_MOCK_TS_FUNCTIONS
+
+} // extern "C"
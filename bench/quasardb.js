@@ -0,0 +1,30 @@
+// Loads the addon for bench/run.js: the build linked with the mock C API, which bench:build puts in bench/binding,
+// or the regular build of lib/binding when QDB_URI is set to run against a cluster.
+
+var fs = require('fs');
+var path = require('path');
+
+function load() {
+    if (process.env.QDB_URI) return require('..');
+
+    var mock = path.join(__dirname, 'binding', 'quasardb.node');
+    if (!fs.existsSync(mock)) {
+        console.error('no mock build in ' + path.dirname(mock) + ', run npm run bench:build first');
+        process.exit(1);
+    }
+
+    // index.js finds its binding with node-pre-gyp, which is pointed to the mock build while it loads
+    var binary = require('@mapbox/node-pre-gyp');
+    var find = binary.find;
+    binary.find = function () {
+        return mock;
+    };
+
+    try {
+        return require('..');
+    } finally {
+        binary.find = find;
+    }
+}
+
+module.exports = load();
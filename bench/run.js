@@ -0,0 +1,225 @@
+// Throughput of the addon, and event loop lag while it runs, reported as JSON on stdout.
+//
+// Meant to be run against the mock C API of bench/mock, which keeps entries in memory and synthesizes time series
+// points and query rows, so that the figures measure the addon rather than a cluster:
+//
+//  npm run bench:build
+//  npm run bench
+//
+// bench:build puts the addon linked with the mock in bench/binding, which bench/quasardb.js loads instead of
+// lib/binding. With QDB_URI set, QDB_URI=qdb://127.0.0.1:2836 npm run bench, it runs against that cluster with the
+// regular build instead. Entries it creates are named after the process and removed at the end.
+//
+// QDB_BENCH_SCALE multiplies the number of operations of every benchmark, 1 by default.
+
+var perf_hooks = require('perf_hooks');
+
+var qdb = require('./quasardb');
+
+var uri = process.env.QDB_URI || 'qdb://127.0.0.1:2836';
+var scale = Number(process.env.QDB_BENCH_SCALE || 1);
+
+// requests in flight at any time, enough to keep the libuv thread pool busy
+var concurrency = 64;
+
+var smallOps = Math.round(20000 * scale);
+var pointsPerInsert = 1000;
+var inserts = Math.round(200 * scale);
+var rangesCalls = Math.round(20 * scale);
+var queryRows = 100000;
+var queries = Math.round(10 * scale);
+
+var prefix = 'bench_' + process.pid + '_';
+var base = new Date(2049, 0, 1);
+
+function timestamp(second) {
+    return qdb.Timestamp.fromDate(new Date(base.getTime() + second * 1000));
+}
+
+// Runs count calls of op(i, callback), at most concurrency at once, then calls done(result). units(i, data) is the
+// number of units, such as points, an operation handled, 1 when omitted.
+function measure(name, unit, count, op, units, done) {
+    var lag = perf_hooks.monitorEventLoopDelay({ resolution: 1 });
+    var total = 0;
+    var next = 0;
+    var completed = 0;
+    var start;
+
+    var finish = function () {
+        var seconds = Number(process.hrtime.bigint() - start) / 1e9;
+        lag.disable();
+
+        done({
+            name: name,
+            unit: unit,
+            operations: count,
+            units: total,
+            seconds: seconds,
+            rate: total / seconds,
+            eventLoopLagMs: {
+                mean: lag.mean / 1e6,
+                p50: lag.percentile(50) / 1e6,
+                p99: lag.percentile(99) / 1e6,
+                max: lag.max / 1e6
+            }
+        });
+    };
+
+    var issue = function () {
+        var i = next++;
+        op(i, function (err, data) {
+            if (err) throw new Error(name + ': ' + err.message);
+
+            total += units ? units(i, data) : 1;
+            if (++completed == count) return finish();
+            if (next < count) issue();
+        });
+    };
+
+    lag.enable();
+    start = process.hrtime.bigint();
+    for (var i = 0; i < Math.min(concurrency, count); i++) {
+        issue();
+    }
+}
+
+// Runs the benchmarks one after the other, each is function (done) calling done(result) or done() when it only
+// prepares the next ones.
+function sequence(benchmarks, done) {
+    var results = [];
+
+    var run = function (i) {
+        if (i == benchmarks.length) return done(results);
+
+        benchmarks[i](function (result) {
+            if (result) results.push(result);
+            run(i + 1);
+        });
+    };
+
+    run(0);
+}
+
+// A benchmark of smallOps operations on small entries, one per alias.
+function small(name, op) {
+    return function (done) { measure(name, 'ops', smallOps, op, null, done); };
+}
+
+function blobBenchmarks(cluster) {
+    var content = Buffer.alloc(64, 'x');
+    var blob = function (i) { return cluster.blob(prefix + 'blob_' + i); };
+
+    return [
+        small('blob.put', function (i, cb) { blob(i).put(content, cb); }),
+        small('blob.get', function (i, cb) { blob(i).get(cb); }),
+        small('blob.update', function (i, cb) { blob(i).update(content, cb); }),
+        small('blob.remove', function (i, cb) { blob(i).remove(cb); })
+    ];
+}
+
+function integerBenchmarks(cluster) {
+    var integer = function (i) { return cluster.integer(prefix + 'int_' + i); };
+
+    return [
+        small('integer.put', function (i, cb) { integer(i).put(i, cb); }),
+        small('integer.get', function (i, cb) { integer(i).get(cb); }),
+        small('integer.add', function (i, cb) { integer(i).add(1, cb); }),
+        small('integer.remove', function (i, cb) { integer(i).remove(cb); })
+    ];
+}
+
+var columnTypes = [
+    { name: 'double', info: function (n) { return qdb.DoubleColumnInfo(n); },
+        point: function (t, i) { return qdb.DoublePoint(t, i * 0.5); } },
+    { name: 'blob', info: function (n) { return qdb.BlobColumnInfo(n); },
+        point: function (t, i) { return qdb.BlobPoint(t, Buffer.from('value_' + i)); } },
+    { name: 'string', info: function (n) { return qdb.StringColumnInfo(n); },
+        point: function (t, i) { return qdb.StringPoint(t, Buffer.from('value_' + i)); } },
+    { name: 'symbol', info: function (n) { return qdb.SymbolColumnInfo(n, 'bench_symtable'); },
+        point: function (t, i) { return qdb.StringPoint(t, Buffer.from('symbol_' + (i % 16))); } },
+    { name: 'int64', info: function (n) { return qdb.Int64ColumnInfo(n); },
+        point: function (t, i) { return qdb.Int64Point(t, i); } },
+    { name: 'timestamp', info: function (n) { return qdb.TimestampColumnInfo(n); },
+        point: function (t, i) { return qdb.TimestampPoint(t, t); } }
+];
+
+function columnBenchmarks(ts) {
+    var columns = null;
+    var benchmarks = [
+        function (done) {
+            ts.create(columnTypes.map(function (type) { return type.info(type.name); }), function (err, created) {
+                if (err) throw err;
+                columns = created;
+                done();
+            });
+        }
+    ];
+
+    columnTypes.forEach(function (type, index) {
+        // the points are built beforehand, the benchmark measures their conversion and insertion
+        var batches = [];
+        for (var b = 0; b < inserts; b++) {
+            var points = new Array(pointsPerInsert);
+            for (var i = 0; i < pointsPerInsert; i++) {
+                var second = b * pointsPerInsert + i;
+                points[i] = type.point(timestamp(second), second);
+            }
+            batches.push(points);
+        }
+
+        // one point per second was inserted, each range covers a tenth of them
+        var span = Math.floor(inserts * pointsPerInsert / 10);
+        var range = function (i) {
+            var begin = (i % 10) * span;
+            return [qdb.TsRange(timestamp(begin), timestamp(begin + span))];
+        };
+
+        benchmarks.push(function (done) {
+            measure('column.' + type.name + '.insert', 'points', inserts,
+                function (i, cb) { columns[index].insert(batches[i], cb); },
+                function (i) { return batches[i].length; }, done);
+        });
+        benchmarks.push(function (done) {
+            measure('column.' + type.name + '.ranges', 'points', rangesCalls,
+                function (i, cb) { columns[index].ranges(range(i), cb); },
+                function (i, points) { return points.length; }, done);
+        });
+    });
+
+    return benchmarks;
+}
+
+function queryBenchmarks(cluster, ts) {
+    var text = 'select * from ' + ts.alias() + ' limit ' + queryRows;
+
+    return [
+        function (done) {
+            measure('query.run', 'rows', queries, function (i, cb) { cluster.query(text).run(cb); },
+                function (i, output) { return output.rows.length; }, done);
+        }
+    ];
+}
+
+var cluster = new qdb.Cluster(uri);
+cluster.connect(function () {
+    var ts = cluster.ts(prefix + 'ts');
+
+    var benchmarks = [].concat(blobBenchmarks(cluster), integerBenchmarks(cluster), columnBenchmarks(ts),
+        queryBenchmarks(cluster, ts));
+
+    sequence(benchmarks, function (results) {
+        ts.remove(function () {
+            console.log(JSON.stringify({
+                uri: uri,
+                node: process.version,
+                concurrency: concurrency,
+                threadPoolSize: Number(process.env.UV_THREADPOOL_SIZE || 4),
+                results: results
+            }, null, 2));
+            process.exit(0);
+        });
+    });
+}, function (err) {
+    console.error('cannot connect to ' + uri + ': ' + err.message);
+    process.exit(1);
+});
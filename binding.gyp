@@ -1,6 +1,11 @@
 {
     "variables": {
         "copy_c_api": "no",
+        # Set to "yes" to add the AVX2 code paths of the time series kernels, used instead of the SSE2 ones when the CPU
+        # supports them. Only src/ts_kernels_avx2.cpp is built with AVX2 enabled.
+        "enable_avx2": "no",
+        # Set to "yes" to link against the mock C API of bench/mock instead of libqdb_api, for the benchmarks.
+        "mock_c_api": "no",
         "c_api_path": "<(module_root_dir)/qdb",
     },
     "targets": [
@@ -10,14 +15,30 @@
                 "src/qdb_api.cpp",
                 "src/entry.hpp",
                 "src/expirable_entry.hpp",
+                "src/batch.cpp",
+                "src/batch.hpp",
                 "src/blob.cpp",
                 "src/blob.hpp",
+                "src/blob_codec.cpp",
+                "src/blob_codec.hpp",
+                "src/blob_cache.cpp",
+                "src/blob_cache.hpp",
                 "src/cluster.cpp",
                 "src/cluster.hpp",
+                "src/conversion_watchdog.cpp",
+                "src/conversion_watchdog.hpp",
+                "src/diagnostics.cpp",
+                "src/diagnostics.hpp",
                 "src/error.cpp",
                 "src/error.hpp",
                 "src/integer.cpp",
                 "src/integer.hpp",
+                "src/key_pager.cpp",
+                "src/key_pager.hpp",
+                "src/op_stats.cpp",
+                "src/op_stats.hpp",
+                "src/keys.cpp",
+                "src/keys.hpp",
                 "src/prefix.cpp",
                 "src/prefix.hpp",
                 "src/query_find.cpp",
@@ -40,6 +61,12 @@
                 "src/ts_range.hpp",
                 "src/ts_aggregation.cpp",
                 "src/ts_aggregation.hpp",
+                "src/ts_downsample.cpp",
+                "src/ts_downsample.hpp",
+                "src/ts_kernels.cpp",
+                "src/ts_kernels.hpp",
+                "src/ts_writer.cpp",
+                "src/ts_writer.hpp",
                 "src/cluster_data.hpp",
                 "src/utilities.cpp",
                 "src/utilities.hpp",
@@ -60,6 +87,7 @@
                 "test/tsGeneralTest.js",
                 "test/tsInt64Test.js",
                 "test/tsStringTest.js",
+                "test/tsSymbolTest.js",
                 "test/tsTimestampTest.js",
             ],
             "conditions": [
@@ -135,6 +163,34 @@
                         ]
                     }
                 ],
+                [
+                    "enable_avx2=='yes'",
+                    {
+                        "dependencies": [
+                            "ts_kernels_avx2"
+                        ],
+                        "defines": [
+                            "QDB_KERNELS_AVX2"
+                        ]
+                    }
+                ],
+                [
+                    "mock_c_api=='yes'",
+                    {
+                        "dependencies": [
+                            "qdb_api_mock"
+                        ],
+                        # Searched before c_api_path, so that the mock is linked even when the C API is installed.
+                        "ldflags": [
+                            "-L<(PRODUCT_DIR)"
+                        ],
+                        "xcode_settings": {
+                            "OTHER_LDFLAGS": [
+                                "-L<(PRODUCT_DIR)"
+                            ]
+                        }
+                    }
+                ],
                 [
                     "OS=='win'",
                     {
@@ -164,6 +220,19 @@
         {
             "target_name": "action_after_build",
             "type": "none",
+            "variables": {
+                "binding_path": "<(module_path)",
+                "conditions": [
+                    [
+                        # The addon linked with the mock, and the mock itself, are kept apart from the regular build,
+                        # see bench/run.js.
+                        "mock_c_api=='yes'",
+                        {
+                            "binding_path": "<(module_root_dir)/bench/binding"
+                        }
+                    ]
+                ]
+            },
             "dependencies": [
                 "<(module_name)"
             ],
@@ -173,7 +242,7 @@
                     {
                         "copies": [
                             {
-                                "destination": "<(module_path)",
+                                "destination": "<(binding_path)",
                                 "files": [
                                     "<(PRODUCT_DIR)/<(module_name).node"
                                 ],
@@ -185,6 +254,14 @@
                                                 "<(c_api_path)/lib/libqdb_api.dylib"
                                             ]
                                         }
+                                    ],
+                                    [
+                                        "mock_c_api=='yes'",
+                                        {
+                                            "files": [
+                                                "<(PRODUCT_DIR)/libqdb_api.dylib"
+                                            ]
+                                        }
                                     ]
                                 ]
                             }
@@ -196,7 +273,7 @@
                     {
                         "copies": [
                             {
-                                "destination": "<(module_path)",
+                                "destination": "<(binding_path)",
                                 "files": [
                                     "<(PRODUCT_DIR)/<(module_name).node"
                                 ],
@@ -208,6 +285,14 @@
                                                 "<(c_api_path)/lib/libqdb_api.so"
                                             ]
                                         }
+                                    ],
+                                    [
+                                        "mock_c_api=='yes'",
+                                        {
+                                            "files": [
+                                                "<(PRODUCT_DIR)/libqdb_api.so"
+                                            ]
+                                        }
                                     ]
                                 ]
                             }
@@ -219,7 +304,7 @@
                     {
                         "copies": [
                             {
-                                "destination": "<(module_path)",
+                                "destination": "<(binding_path)",
                                 "files": [
                                     "<(PRODUCT_DIR)/<(module_name).node"
                                 ],
@@ -239,5 +324,81 @@
                 ]
             ]
         }
+    ],
+    "conditions": [
+        [
+            "enable_avx2=='yes'",
+            {
+                "targets": [
+                    {
+                        # The AVX2 loops of the kernels, kept apart so that the rest of the addon runs on any CPU.
+                        "target_name": "ts_kernels_avx2",
+                        "type": "static_library",
+                        "sources": [
+                            "src/ts_kernels_avx2.cpp"
+                        ],
+                        "defines": [
+                            "QDB_KERNELS_AVX2"
+                        ],
+                        "include_dirs": [
+                            "/usr/local/include",
+                            "<(c_api_path)/include"
+                        ],
+                        "cflags": [
+                            "-std=c++14",
+                            "-fPIC",
+                            "-mavx2"
+                        ],
+                        "xcode_settings": {
+                            "CLANG_CXX_LIBRARY": "libc++",
+                            "CLANG_CXX_LANGUAGE_STANDARD": "c++14",
+                            "MACOSX_DEPLOYMENT_TARGET": "10.14",
+                            "OTHER_CFLAGS": [
+                                "-mavx2"
+                            ]
+                        },
+                        "msvs_settings": {
+                            "VCCLCompilerTool": {
+                                "AdditionalOptions": [
+                                    "/arch:AVX2"
+                                ]
+                            }
+                        }
+                    }
+                ]
+            }
+        ],
+        [
+            "mock_c_api=='yes' and OS!='win'",
+            {
+                "targets": [
+                    {
+                        # Stand-in for libqdb_api returning synthetic data, see bench/mock/qdb_api_mock.cpp.
+                        "target_name": "qdb_api_mock",
+                        "product_prefix": "lib",
+                        "product_name": "qdb_api",
+                        "type": "shared_library",
+                        "sources": [
+                            "bench/mock/qdb_api_mock.cpp"
+                        ],
+                        "include_dirs": [
+                            "<(c_api_path)/include"
+                        ],
+                        "cflags": [
+                            "-std=c++14"
+                        ],
+                        "cflags_cc!": [
+                            "-fno-exceptions"
+                        ],
+                        "xcode_settings": {
+                            "CLANG_CXX_LIBRARY": "libc++",
+                            "CLANG_CXX_LANGUAGE_STANDARD": "c++14",
+                            "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+                            "LD_DYLIB_INSTALL_NAME": "@rpath/libqdb_api.dylib"
+                        }
+                    }
+                ]
+            }
+        ]
     ]
 }
@@ -12,4 +12,18 @@ quasardb.Timestamp.prototype.toString = function () {
   return `${formattedDateTime}.${formattedNanoseconds}Z`
 }
 
-module.exports = exports = quasardb;
\ No newline at end of file
+// symbol columns are string columns served through a symbol table
+Object.setPrototypeOf(quasardb.SymbolColumn.prototype, quasardb.StringColumn.prototype)
+
+// operations on many entries, see Batch
+for (const name of ['expireMany', 'prefixes', 'tagsEntries', 'attachTagToMany', 'detachTagFromMany']) {
+  quasardb.Cluster.prototype[name] = function (...args) {
+    return this.batch()[name](...args)
+  }
+}
+
+require('./lib/blob_stream')(quasardb)
+require('./lib/diagnostics')(quasardb)
+require('./lib/key_iterator')(quasardb)
+
+module.exports = exports = quasardb;
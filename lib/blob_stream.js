@@ -0,0 +1,325 @@
+// Chunked blob streams.
+//
+// The C API reads and writes blobs as a whole, large values are thus split in chunks stored as separate blobs named
+// `<alias>.chunk.<generation>.<index>`, and the blob itself holds a small manifest describing them. Every write uses a
+// new random generation, so chunks are never overwritten in place: the manifest is written last, once every chunk is
+// stored, and switches readers to the new chunks at once. The chunks of the previous generation are removed afterwards.
+// The switch is a compare and swap against the value read before it, a concurrent writer thus fails instead of leaving
+// the chunks of the value it replaced behind.
+//
+// Reading a blob which is not a manifest streams its content as is, sliced in chunkSize pieces. The size of the stored
+// value is looked up first, only values small enough to be a manifest are read to tell them apart.
+
+const crypto = require('crypto')
+const { Readable, Writable } = require('stream')
+
+const MANIFEST_MAGIC = Buffer.from('QDBCHNK1')
+const DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024
+// manifests are about a hundred bytes, stored values larger than this are never one
+const MANIFEST_MAX_SIZE = 1024
+
+// set by install, error codes are exported by the addon
+let E_ALIAS_NOT_FOUND = null
+
+const chunkAlias = (alias, generation, index) => `${alias}.chunk.${generation}.${index}`
+
+function makeManifest (size, chunkSize, chunks, generation) {
+  return Buffer.concat([MANIFEST_MAGIC, Buffer.from(JSON.stringify({ size, chunkSize, chunks, generation }))])
+}
+
+function parseManifest (data) {
+  // data is null for a missing blob when the cluster reports missing entries as null
+  if (!data || data.length <= MANIFEST_MAGIC.length || !data.subarray(0, MANIFEST_MAGIC.length).equals(MANIFEST_MAGIC)) {
+    return null
+  }
+
+  try {
+    const manifest = JSON.parse(data.subarray(MANIFEST_MAGIC.length).toString())
+    const valid = Number.isInteger(manifest.size) && Number.isInteger(manifest.chunks) &&
+      typeof manifest.generation === 'string'
+    return valid ? manifest : null
+  } catch (err) {
+    return null
+  }
+}
+
+// Reads the stored value when it may be a manifest. The callback gets the metadata, null for a missing blob, and the
+// value, undefined when it is too large to be a manifest.
+function probe (blob, callback) {
+  blob.getMetadata((err, meta) => {
+    if (err && err.code !== E_ALIAS_NOT_FOUND) return callback(err)
+    if (err || !meta) return callback(null, null)
+    if (meta.size > MANIFEST_MAX_SIZE) return callback(null, meta)
+
+    blob.get((err, data) => {
+      if (err && err.code !== E_ALIAS_NOT_FOUND) return callback(err)
+      callback(null, err || !data ? null : meta, err ? undefined : data)
+    })
+  })
+}
+
+// Removes the chunks [from, to) of a generation, errors are ignored: a chunk already removed is what is wanted, and the
+// remaining ones are only wasted space.
+function removeChunks (cluster, alias, generation, from, to, callback) {
+  if (from >= to) return callback()
+
+  cluster.blob(chunkAlias(alias, generation, from)).remove(() => {
+    removeChunks(cluster, alias, generation, from + 1, to, callback)
+  })
+}
+
+function chunkSizeOption (options) {
+  const chunkSize = (options && options.chunkSize) || DEFAULT_CHUNK_SIZE
+  if (!Number.isInteger(chunkSize) || chunkSize <= 0) {
+    throw new TypeError('chunkSize must be a positive integer')
+  }
+  return chunkSize
+}
+
+class BlobReadStream extends Readable {
+  constructor (cluster, blob, options) {
+    const chunkSize = chunkSizeOption(options)
+    // at most one chunk is fetched ahead of the consumer
+    super({ highWaterMark: chunkSize })
+
+    // same as fs streams, end is inclusive
+    const start = (options && options.start) || 0
+    const end = options && options.end !== undefined ? options.end : Infinity
+    if (!Number.isInteger(start) || start < 0 || !(end === Infinity || Number.isInteger(end))) {
+      throw new TypeError('start and end must be non negative integers')
+    }
+
+    this._cluster = cluster
+    this._blob = blob
+    this._chunkSize = chunkSize
+    this._start = start
+    this._end = end
+    this._manifest = null
+    this._value = null
+    this._offset = start
+    this._next = 0
+  }
+
+  _read () {
+    if (this._value) return this._pushValue()
+    if (this._manifest) return this._pushChunk()
+
+    this._blob.getMetadata((err, meta) => {
+      if (err) return this.destroy(err)
+      // missing blob reported as null
+      if (!meta) return this.push(null)
+
+      if (meta.size > MANIFEST_MAX_SIZE) return this._readValue()
+
+      this._blob.get((err, data) => {
+        if (err) return this.destroy(err)
+
+        this._manifest = parseManifest(data)
+        if (!this._manifest) return this._takeValue((data || Buffer.alloc(0)).subarray(this._start, this._end + 1))
+        this._readChunks()
+      })
+    })
+  }
+
+  // only the requested part of a plain value is kept
+  _readValue () {
+    const length = this._end === Infinity ? Number.MAX_SAFE_INTEGER : this._end + 1 - this._start
+    this._blob.getRange(this._start, Math.max(length, 0), (err, data) => {
+      if (err) return this.destroy(err)
+      this._takeValue(data || Buffer.alloc(0))
+    })
+  }
+
+  _takeValue (value) {
+    this._value = value
+    this._offset = 0
+    this._pushValue()
+  }
+
+  _readChunks () {
+
+    // only the chunks overlapping the requested part are fetched
+    this._next = Math.floor(this._start / this._manifest.chunkSize)
+    this._offset = this._next * this._manifest.chunkSize
+    this._pushChunk()
+  }
+
+  _pushValue () {
+    if (this._offset >= this._value.length) return this.push(null)
+
+    const end = Math.min(this._offset + this._chunkSize, this._value.length)
+    const slice = this._value.subarray(this._offset, end)
+    this._offset = end
+    this.push(slice)
+  }
+
+  _pushChunk () {
+    const manifest = this._manifest
+
+    if (this._next === manifest.chunks || this._offset > this._end) {
+      if (this._next === manifest.chunks && this._offset !== manifest.size) {
+        return this.destroy(new Error(`Chunked blob ${this._blob.alias()} is truncated`))
+      }
+      return this.push(null)
+    }
+
+    const alias = chunkAlias(this._blob.alias(), manifest.generation, this._next++)
+    this._cluster.blob(alias).get((err, data) => {
+      if (err) return this.destroy(err)
+
+      const position = this._offset
+      this._offset += data.length
+      this.push(data.subarray(Math.max(this._start - position, 0), this._end + 1 - position))
+    })
+  }
+}
+
+class BlobWriteStream extends Writable {
+  constructor (cluster, blob, options) {
+    const chunkSize = chunkSizeOption(options)
+    super({ highWaterMark: chunkSize })
+
+    this._cluster = cluster
+    this._blob = blob
+    this._chunkSize = chunkSize
+    this._expiry = options && options.expiry
+    this._pending = []
+    this._pendingLength = 0
+    this._size = 0
+    this._chunks = 0
+    this._generation = crypto.randomBytes(8).toString('hex')
+    this._committed = false
+  }
+
+  _update (blob, data, callback) {
+    if (this._expiry) {
+      blob.update(data, this._expiry, callback)
+    } else {
+      blob.update(data, callback)
+    }
+  }
+
+  // switches the blob to the manifest if it still holds the value probed, the callback gets the value replaced when it
+  // is known to be a manifest
+  _switch (meta, previous, manifest, callback) {
+    const args = this._expiry ? [manifest, this._expiry] : [manifest]
+
+    if (!meta) {
+      // fails with E_ALIAS_ALREADY_EXISTS when a concurrent write created it first
+      return this._blob.put(...args, (err) => callback(err, null))
+    }
+
+    if (previous !== undefined) {
+      return this._blob.compareAndSwap(args[0], previous, ...args.slice(1), (err) => callback(err, previous))
+    }
+
+    // a plain value too large to be a manifest has no chunks, but could have been replaced by a concurrent streamed
+    // write since: it is swapped atomically and read back, which is the only case where the previous value is
+    // transferred
+    this._blob.getAndUpdate(...args, callback)
+  }
+
+  _takeChunk () {
+    const length = Math.min(this._chunkSize, this._pendingLength)
+    const data = this._pending.length === 1 ? this._pending[0] : Buffer.concat(this._pending, this._pendingLength)
+
+    this._pending = length < data.length ? [data.subarray(length)] : []
+    this._pendingLength -= length
+    return data.subarray(0, length)
+  }
+
+  // stores full chunks, and the remainder when flushing, the buffers are pinned by the update requests
+  _store (flush, callback) {
+    if (!this._pendingLength || (!flush && this._pendingLength < this._chunkSize)) return callback()
+
+    const chunk = this._takeChunk()
+    const alias = chunkAlias(this._blob.alias(), this._generation, this._chunks)
+    this._update(this._cluster.blob(alias), chunk, (err) => {
+      if (err) return callback(err)
+
+      this._chunks++
+      this._size += chunk.length
+      this._store(flush, callback)
+    })
+  }
+
+  _write (data, encoding, callback) {
+    this._pending.push(data)
+    this._pendingLength += data.length
+    this._store(false, callback)
+  }
+
+  _final (callback) {
+    this._store(true, (err) => {
+      if (err) return callback(err)
+
+      // the previous value, if streamed, is read before the switch to find the chunks to remove after it
+      probe(this._blob, (err, meta, data) => {
+        if (err) return callback(err)
+
+        const manifest = makeManifest(this._size, this._chunkSize, this._chunks, this._generation)
+        this._switch(meta, data, manifest, (err, replaced) => {
+          if (err) return callback(err)
+
+          this._committed = true
+          const previous = parseManifest(replaced)
+          if (!previous || previous.generation === this._generation) return callback()
+          removeChunks(this._cluster, this._blob.alias(), previous.generation, 0, previous.chunks, callback)
+        })
+      })
+    })
+  }
+
+  // the chunks of a write which failed or was aborted are not referenced by any manifest
+  _destroy (err, callback) {
+    if (this._committed || !this._chunks) return callback(err)
+    removeChunks(this._cluster, this._blob.alias(), this._generation, 0, this._chunks, () => callback(err))
+  }
+}
+
+// Removes a blob and, if it was written by a stream, its chunks. The chunks are removed once the manifest is, readers
+// of the removed value may thus fail to read them.
+function removeStreamed (cluster, blob, callback) {
+  probe(blob, (err, meta, data) => {
+    if (err) return callback(err)
+
+    const manifest = parseManifest(data)
+    blob.remove((err) => {
+      if (err || !manifest) return callback(err || null)
+      removeChunks(cluster, blob.alias(), manifest.generation, 0, manifest.chunks, () => callback(null))
+    })
+  })
+}
+
+// Blobs do not know the cluster they were created from, the chunks need it to be addressed.
+const clusters = new WeakMap()
+
+function clusterOf (blob) {
+  const cluster = clusters.get(blob)
+  if (!cluster) throw new Error('Blob streams require a blob created with Cluster.blob()')
+  return cluster
+}
+
+module.exports = function install (quasardb) {
+  E_ALIAS_NOT_FOUND = quasardb.E_ALIAS_NOT_FOUND
+
+  const blob = quasardb.Cluster.prototype.blob
+
+  quasardb.Cluster.prototype.blob = function (alias) {
+    const b = blob.call(this, alias)
+    clusters.set(b, this)
+    return b
+  }
+
+  quasardb.Blob.prototype.createReadStream = function (options) {
+    return new BlobReadStream(clusterOf(this), this, options)
+  }
+
+  quasardb.Blob.prototype.createWriteStream = function (options) {
+    return new BlobWriteStream(clusterOf(this), this, options)
+  }
+
+  quasardb.Blob.prototype.removeStreamed = function (callback) {
+    removeStreamed(clusterOf(this), this, callback)
+  }
+}
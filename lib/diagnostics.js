@@ -0,0 +1,13 @@
+// Publishes the requests on diagnostics channels, for tracing and APM tools.
+//
+// quasardb:request:start receives {operation, alias} when a request is made, operation being such as Blob.get. The
+// same object is published on quasardb:request:end once the request is over, before its callback is called, with
+// error, null on success, and duration, in milliseconds. Both are published in the async context of the call.
+
+const diagnosticsChannel = require('diagnostics_channel')
+
+module.exports = function install (quasardb) {
+  quasardb.setDiagnosticsChannels(
+    diagnosticsChannel.channel('quasardb:request:start'),
+    diagnosticsChannel.channel('quasardb:request:end'))
+}
@@ -0,0 +1,49 @@
+// Paginated enumeration of the aliases matching a prefix or a suffix.
+//
+// Pages come from getPage, which runs on the worker thread. The next page is requested as soon as a page is handed
+// out, so that it is fetched while the caller processes the current one. Every page carries the token to resume the
+// enumeration after it.
+
+const DEFAULT_PAGE_SIZE = 10000
+
+function getPage (lookup, pageSize, token) {
+  const page = new Promise((resolve, reject) => {
+    lookup.getPage(pageSize, token, (err, aliases, next) => {
+      if (err) return reject(err)
+      resolve({ aliases, token: next })
+    })
+  })
+
+  // the caller may stop iterating before a prefetched page is awaited
+  page.catch(() => {})
+  return page
+}
+
+async function * pages (lookup, pageSize, token) {
+  let next = getPage(lookup, pageSize, token)
+
+  while (next) {
+    const page = await next
+    next = page.token ? getPage(lookup, pageSize, page.token) : null
+    yield page
+  }
+}
+
+function iterate (options) {
+  const pageSize = (options && options.pageSize) || DEFAULT_PAGE_SIZE
+  if (!Number.isInteger(pageSize) || pageSize <= 0) {
+    throw new TypeError('pageSize must be a positive integer')
+  }
+
+  const token = (options && options.token) || Buffer.alloc(0)
+  if (!Buffer.isBuffer(token)) {
+    throw new TypeError('token must be a Buffer returned by a previous page')
+  }
+
+  return pages(this, pageSize, token)
+}
+
+module.exports = function install (quasardb) {
+  quasardb.Prefix.prototype.iterate = iterate
+  quasardb.Suffix.prototype.iterate = iterate
+}
@@ -0,0 +1,469 @@
+#include "batch.hpp"
+#include "cluster.hpp"
+#include <qdb/prefix.h>
+#include <qdb/tag.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace quasardb
+{
+
+v8::Persistent<v8::Function> Batch::constructor;
+
+void Batch::New(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Cluster::newObject<Batch>(args);
+}
+
+void Batch::expireMany(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Batch * b = node::ObjectWrap::Unwrap<Batch>(args.Holder());
+    assert(b);
+
+    // cached blob contents must not outlive their new expiry, they are invalidated once the expiries are set
+    cluster_data_ptr cd = b->cluster_data();
+    blob_cache_ptr cache = cd ? cd->get_blob_cache() : nullptr;
+
+    Entry<Batch>::queue_work(
+        args,
+        [cache](qdb_request * qdb_req)
+        {
+            Batch::executeExpireMany(qdb_req);
+            if (!cache) return;
+
+            for (const auto & alias : qdb_req->input.content.strs)
+            {
+                cache->invalidate(alias);
+            }
+        },
+        Batch::processBatchResult, &ArgsEaterBinder::strings, &ArgsEaterBinder::deadline,
+        &ArgsEaterBinder::batchOptions);
+}
+
+void Batch::prefixes(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Entry<Batch>::queue_work(
+        args,
+        [](qdb_request * qdb_req)
+        {
+            Batch::executeLookups(qdb_req,
+                [](qdb_request * qdb_req, const char * prefix, const char *** aliases, size_t * count)
+                {
+                    return qdb_prefix_get(
+                        qdb_req->handle(), prefix, /*max_count=*/qdb_req->input.content.value, aliases, count);
+                });
+        },
+        Batch::processLookupsResult, &ArgsEaterBinder::strings, &ArgsEaterBinder::integer,
+        &ArgsEaterBinder::batchOptions);
+}
+
+void Batch::tagsEntries(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Entry<Batch>::queue_work(
+        args,
+        [](qdb_request * qdb_req)
+        {
+            Batch::executeLookups(qdb_req,
+                [](qdb_request * qdb_req, const char * tag, const char *** aliases, size_t * count)
+                { return qdb_get_tagged(qdb_req->handle(), tag, aliases, count); });
+        },
+        Batch::processLookupsResult, &ArgsEaterBinder::strings, &ArgsEaterBinder::batchOptions);
+}
+
+void Batch::attachTagToMany(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Entry<Batch>::queue_work(
+        args, [](qdb_request * qdb_req) { Batch::executeTagMany(qdb_req, qdb_attach_tag); },
+        Batch::processBatchResult, &ArgsEaterBinder::strings, &ArgsEaterBinder::string,
+        &ArgsEaterBinder::batchOptions);
+}
+
+void Batch::detachTagFromMany(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Entry<Batch>::queue_work(
+        args, [](qdb_request * qdb_req) { Batch::executeTagMany(qdb_req, qdb_detach_tag); },
+        Batch::processBatchResult, &ArgsEaterBinder::strings, &ArgsEaterBinder::string,
+        &ArgsEaterBinder::batchOptions);
+}
+
+namespace
+{
+
+// threads shared by the requests running, on top of the worker threads running them
+const size_t max_batch_threads = 3;
+
+// The threads helping the batches run their chunks. They are created with libuv on first use, as many as could be of
+// max_batch_threads, and stopped and joined once the last environment using them is torn down.
+class batch_threads
+{
+public:
+    static batch_threads & instance()
+    {
+        // never destroyed, requests still running after the teardown run their chunks alone
+        static batch_threads * threads = new batch_threads();
+        return *threads;
+    }
+
+    void attach()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_environments;
+    }
+
+    // from the cleanup hook of an environment, on its JS thread
+    static void detach(void * arg)
+    {
+        batch_threads * self = static_cast<batch_threads *>(arg);
+
+        std::vector<uv_thread_t> threads;
+        {
+            std::lock_guard<std::mutex> lock(self->_mutex);
+            if (--self->_environments > 0) return;
+
+            self->_stopping = true;
+            threads.swap(self->_threads);
+        }
+        self->_wake.notify_all();
+
+        for (auto & thread : threads)
+        {
+            uv_thread_join(&thread);
+        }
+
+        std::lock_guard<std::mutex> lock(self->_mutex);
+        self->_stopping = false;
+        self->_started = false;
+    }
+
+    // Calls f(chunk) for every chunk of the count, from the calling thread and from the threads not busy with other
+    // requests. Returns once every chunk was handled.
+    template <typename F>
+    void run(size_t count, F f)
+    {
+        job j{count, f};
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            start();
+            _jobs.push_back(&j);
+        }
+        _wake.notify_all();
+
+        // runs whatever chunks the threads did not take, all of them when they are busy or could not be created
+        j.work();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        withdraw(&j);
+        _idle.wait(lock, [&j]() { return j.helpers == 0; });
+    }
+
+private:
+    struct job
+    {
+        job(size_t c, std::function<void(size_t)> fn)
+            : count(c)
+            , f(std::move(fn))
+        {
+        }
+
+        void work()
+        {
+            for (size_t chunk = next++; chunk < count; chunk = next++)
+            {
+                f(chunk);
+            }
+        }
+
+        const size_t count;
+        const std::function<void(size_t)> f;
+        std::atomic<size_t> next{0};
+        // threads working on the job, guarded by the mutex
+        size_t helpers = 0;
+    };
+
+    batch_threads() = default;
+
+    // with the mutex held, the threads are only started while an environment uses them
+    void start()
+    {
+        if (_started || _stopping || (_environments == 0)) return;
+        _started = true;
+
+        for (size_t i = 0; i < max_batch_threads; ++i)
+        {
+            uv_thread_t thread;
+            if (uv_thread_create(&thread, &batch_threads::help, this) != 0) break;
+            _threads.push_back(thread);
+        }
+    }
+
+    static void help(void * arg)
+    {
+        batch_threads * self = static_cast<batch_threads *>(arg);
+
+        std::unique_lock<std::mutex> lock(self->_mutex);
+        for (;;)
+        {
+            self->_wake.wait(lock, [self]() { return self->_stopping || !self->_jobs.empty(); });
+            if (self->_stopping) return;
+
+            job * j = self->_jobs.front();
+            ++j->helpers;
+
+            lock.unlock();
+            j->work();
+            lock.lock();
+
+            // every chunk is taken, the job no longer needs help
+            self->withdraw(j);
+            --j->helpers;
+            self->_idle.notify_all();
+        }
+    }
+
+    // with the mutex held
+    void withdraw(job * j)
+    {
+        auto it = std::find(_jobs.begin(), _jobs.end(), j);
+        if (it != _jobs.end()) _jobs.erase(it);
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _idle;
+    std::deque<job *> _jobs;
+
+    std::vector<uv_thread_t> _threads;
+    size_t _environments = 0;
+    bool _started = false;
+    bool _stopping = false;
+};
+
+// Calls f(begin, end) for consecutive ranges of at most chunk_size of the count items, from the calling thread and the
+// batch threads.
+template <typename F>
+void run_in_parallel(size_t count, size_t chunk_size, F f)
+{
+    const size_t chunks = (count + chunk_size - 1) / chunk_size;
+    auto run_chunk = [&](size_t chunk)
+    {
+        const size_t begin = chunk * chunk_size;
+        f(begin, std::min(begin + chunk_size, count));
+    };
+
+    if (chunks <= 1)
+    {
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            run_chunk(chunk);
+        }
+        return;
+    }
+
+    batch_threads::instance().run(chunks, run_chunk);
+}
+
+struct c_string_hash
+{
+    size_t operator()(const char * s) const
+    {
+        // FNV-1a
+        size_t h = static_cast<size_t>(14695981039346656037ull);
+        for (; *s; ++s)
+        {
+            h = (h ^ static_cast<unsigned char>(*s)) * static_cast<size_t>(1099511628211ull);
+        }
+        return h;
+    }
+};
+
+struct c_string_equal
+{
+    bool operator()(const char * lhs, const char * rhs) const
+    {
+        return std::strcmp(lhs, rhs) == 0;
+    }
+};
+
+} // namespace
+
+void Batch::attachThreads(v8::Isolate * isolate)
+{
+    batch_threads & threads = batch_threads::instance();
+    threads.attach();
+    node::AddEnvironmentCleanupHook(isolate, &batch_threads::detach, &threads);
+}
+
+void Batch::executeLookups(qdb_request * qdb_req, const lookup_function & lookup)
+{
+    const auto & keys = qdb_req->input.content.strs;
+    auto & results = qdb_req->output.lookups.results;
+    auto & aliases = qdb_req->output.lookups.aliases;
+
+    results.assign(keys.size(), qdb_request::slice{nullptr, 0});
+    std::vector<qdb_error_t> errors(keys.size(), qdb_e_ok);
+
+    // lookups are handed out one at a time, they are few and each may be long
+    run_in_parallel(keys.size(), 1,
+        [&](size_t i, size_t)
+        {
+            errors[i] = lookup(qdb_req, keys[i].c_str(),
+                reinterpret_cast<const char ***>(const_cast<void **>(&results[i].begin)), &results[i].size);
+
+            // no match is an empty result
+            if (errors[i] != qdb_e_ok) results[i] = qdb_request::slice{nullptr, 0};
+        });
+
+    auto failed = std::find_if(errors.cbegin(), errors.cend(),
+        [](qdb_error_t err) { return (err != qdb_e_ok) && (err != qdb_e_alias_not_found); });
+    qdb_req->output.error = (failed == errors.cend()) ? qdb_e_ok : *failed;
+    if (qdb_req->output.error != qdb_e_ok) return;
+
+    std::unordered_set<const char *, c_string_hash, c_string_equal> seen;
+
+    aliases.resize(results.size());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const char ** entries = reinterpret_cast<const char **>(const_cast<void *>(results[i].begin));
+        const size_t count = results[i].size;
+
+        if (!qdb_req->input.content.batch.dedupe)
+        {
+            aliases[i].assign(entries, entries + count);
+            continue;
+        }
+
+        // the first lookup returning an alias keeps it
+        aliases[i].reserve(count);
+        std::copy_if(entries, entries + count, std::back_inserter(aliases[i]),
+            [&seen](const char * alias) { return seen.insert(alias).second; });
+    }
+}
+
+void Batch::executeExpireMany(qdb_request * qdb_req)
+{
+    const auto & aliases = qdb_req->input.content.strs;
+    auto & statuses = qdb_req->output.batch.statuses;
+
+    // the batch API has no expiry operation, every alias is a call of its own
+    statuses.resize(aliases.size());
+
+    run_in_parallel(aliases.size(), qdb_req->input.content.batch.batch_size,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                statuses[i] = qdb_expires_at(qdb_req->handle(), aliases[i].c_str(), qdb_req->input.expiry);
+            }
+        });
+
+    qdb_req->output.batch.success_count =
+        static_cast<qdb_size_t>(std::count(statuses.cbegin(), statuses.cend(), qdb_e_ok));
+    qdb_req->output.error = qdb_e_ok;
+}
+
+void Batch::executeTagMany(qdb_request * qdb_req, tag_function f)
+{
+    const auto & aliases = qdb_req->input.content.strs;
+    const char * tag = qdb_req->input.content.str.c_str();
+    auto & statuses = qdb_req->output.batch.statuses;
+
+    // the batch API has no tag operation, every alias is a call of its own
+    statuses.resize(aliases.size());
+
+    run_in_parallel(aliases.size(), qdb_req->input.content.batch.batch_size,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                statuses[i] = f(qdb_req->handle(), aliases[i].c_str(), tag);
+            }
+        });
+
+    qdb_req->output.batch.success_count =
+        static_cast<qdb_size_t>(std::count(statuses.cbegin(), statuses.cend(), qdb_e_ok));
+    qdb_req->output.error = qdb_e_ok;
+}
+
+void Batch::processBatchResult(uv_work_t * req, int status)
+{
+    processResult<3>(req, status,
+        [&](v8::Isolate * isolate, qdb_request * qdb_req)
+        {
+            const auto error_code = processErrorCode(isolate, status, qdb_req);
+            auto success_count = v8::Number::New(isolate, static_cast<double>(qdb_req->output.batch.success_count));
+            v8::Local<v8::Object> obj = v8::Object::New(isolate);
+
+            const auto & aliases = qdb_req->input.content.strs;
+            const auto & statuses = qdb_req->output.batch.statuses;
+
+            auto context = isolate->GetCurrentContext();
+            for (size_t i = 0; i < statuses.size(); ++i)
+            {
+                v8::Local<v8::Value> status = v8::Null(isolate);
+                if (statuses[i] != qdb_e_ok) status = Error::MakeError(isolate, statuses[i]);
+
+                const int length = static_cast<int>(aliases[i].size());
+                v8::Local<v8::String> alias =
+                    v8::String::NewFromUtf8(isolate, aliases[i].c_str(), v8::NewStringType::kNormal, length)
+                        .ToLocalChecked();
+
+                // defined rather than assigned, so that aliases such as __proto__ are plain fields
+                obj->CreateDataProperty(context, alias, status).Check();
+            }
+
+            return make_value_array(error_code, success_count, obj);
+        });
+}
+
+void Batch::processLookupsResult(uv_work_t * req, int status)
+{
+    processResult<2>(req, status,
+        [&](v8::Isolate * isolate, qdb_request * qdb_req)
+        {
+            auto error_code = processErrorCode(isolate, status, qdb_req);
+            v8::Local<v8::Object> obj = v8::Object::New(isolate);
+
+            const auto & keys = qdb_req->input.content.strs;
+            const auto & results = qdb_req->output.lookups.results;
+            const auto & aliases = qdb_req->output.lookups.aliases;
+
+            auto context = isolate->GetCurrentContext();
+            for (size_t i = 0; i < aliases.size(); ++i)
+            {
+                const int length = static_cast<int>(keys[i].size());
+                v8::Local<v8::String> key =
+                    v8::String::NewFromUtf8(isolate, keys[i].c_str(), v8::NewStringType::kNormal, length)
+                        .ToLocalChecked();
+
+                // a key given twice keeps the result of its first lookup, the only one holding aliases when deduped
+                if (obj->HasOwnProperty(context, key).FromMaybe(false)) continue;
+
+                v8::Local<v8::Array> array = v8::Array::New(isolate, static_cast<int>(aliases[i].size()));
+                for (size_t j = 0; j < aliases[i].size(); ++j)
+                {
+                    array->Set(context, static_cast<uint32_t>(j),
+                        v8::String::NewFromUtf8(isolate, aliases[i][j], v8::NewStringType::kNormal).ToLocalChecked());
+                }
+
+                // defined rather than assigned, so that keys such as __proto__ are plain fields
+                obj->CreateDataProperty(context, key, array).Check();
+            }
+
+            // the aliases point into the arrays of the C API, released once converted, or on failure
+            for (const auto & result : results)
+            {
+                qdb_release(qdb_req->handle(), result.begin);
+            }
+
+            return make_value_array(error_code, obj);
+        });
+}
+
+} // namespace quasardb
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "entry.hpp"
+
+#include <qdb/client.h>
+
+#include <node.h>
+#include <node_buffer.h>
+#include <node_object_wrap.h>
+#include <uv.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace quasardb
+{
+
+class Cluster;
+
+// Operations applied to many aliases at once, in a single request. The request runs on one worker task, which shares
+// the work with the threads helping the batches, one call to the C API per alias or lookup.
+class Batch : public Entry<Batch>
+{
+    friend class Entry<Batch>;
+    friend class Cluster;
+
+public:
+    static const size_t ParameterCount = 0;
+
+private:
+    Batch(cluster_data_ptr cd)
+        : Entry<Batch>(cd, "")
+    {
+    }
+
+    virtual ~Batch(void)
+    {
+    }
+
+public:
+    static void Init(v8::Local<v8::Object> exports)
+    {
+        Entry<Batch>::InitConstructorOnly(exports, "Batch",
+            [](v8::Local<v8::FunctionTemplate> tpl)
+            {
+                detail::SetOperation(tpl, "expireMany", expireMany);
+                detail::SetOperation(tpl, "prefixes", prefixes);
+                detail::SetOperation(tpl, "tagsEntries", tagsEntries);
+                detail::SetOperation(tpl, "attachTagToMany", attachTagToMany);
+                detail::SetOperation(tpl, "detachTagFromMany", detachTagFromMany);
+            });
+
+        attachThreads(exports->GetIsolate());
+    }
+
+public:
+    // :desc: Sets the expiration time of many entries. The batch API has no expiry operation: every entry costs a call
+    // to the C API, thus a round trip to the cluster, the calls run on up to four threads at once.
+    // :args: aliases (String[]) - The aliases of the entries.
+    // expiry (Date|int) - A Date at which the entries expire, or a number of milliseconds from call time.
+    // options (Object) - Optional, {batchSize} the number of entries handed at once to the worker thread or to one of
+    // the threads shared by the batch requests, 1000 by default.
+    // callback(err, success_count, result) (function) - A callback or anonymous function with: error parameter, number
+    // of entries updated and result. Result is an Object with a field per alias, null when the expiry was set, the
+    // error otherwise.
+    static void expireMany(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+    // :desc: Gets the aliases matching many prefixes, the lookups run concurrently.
+    // :args: prefixes (String[]) - The prefixes to look up.
+    // maxCount (int) - maximum count of aliases returned per prefix.
+    // options (Object) - Optional, {dedupe: true} to return every alias once, under the first prefix matching it.
+    // callback(err, result) (function) - A callback function with err and result parameters. Result is an Object with
+    // the array of aliases of each prefix.
+    static void prefixes(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+    // :desc: Gets the entities associated with many tags, the lookups run concurrently.
+    // :args: tags (String[]) - The names of the tags.
+    // options (Object) - Optional, {dedupe: true} to return every alias once, under the first tag it is associated to.
+    // callback(err, result) (function) - A callback function with err and result parameters. Result is an Object with
+    // the array of entities of each tag.
+    static void tagsEntries(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+    // :desc: Attaches a tag to many entries. The batch API has no tag operation: every entry costs a call to the C API,
+    // thus a round trip to the cluster, the calls run on up to four threads at once.
+    // :args: aliases (String[]) - The aliases of the entries.
+    // tagName (String) - The name of the tag.
+    // options (Object) - Optional, {batchSize} the number of entries handed at once to the worker thread or to one of
+    // the threads shared by the batch requests, 1000 by default.
+    // callback(err, success_count, result) (function) - A callback or anonymous function with: error parameter, number
+    // of entries tagged and result. Result is an Object with a field per alias, null when the tag was attached, the
+    // error otherwise.
+    static void attachTagToMany(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+    // :desc: Detaches a tag from many entries. The batch API has no tag operation: every entry costs a call to the C
+    // API, thus a round trip to the cluster, the calls run on up to four threads at once.
+    // :args: aliases (String[]) - The aliases of the entries.
+    // tagName (String) - The name of the tag.
+    // options (Object) - Optional, {batchSize} the number of entries handed at once to the worker thread or to one of
+    // the threads shared by the batch requests, 1000 by default.
+    // callback(err, success_count, result) (function) - A callback or anonymous function with: error parameter, number
+    // of entries untagged and result. Result is an Object with a field per alias, null when the tag was detached, the
+    // error otherwise.
+    static void detachTagFromMany(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+private:
+    using lookup_function = std::function<qdb_error_t(qdb_request *, const char *, const char ***, size_t *)>;
+    using tag_function = qdb_error_t (*)(qdb_handle_t, const char *, const char *);
+
+    static void executeExpireMany(qdb_request * qdb_req);
+
+    static void executeLookups(qdb_request * qdb_req, const lookup_function & lookup);
+
+    static void executeTagMany(qdb_request * qdb_req, tag_function f);
+
+    static void processBatchResult(uv_work_t * req, int status);
+
+    static void processLookupsResult(uv_work_t * req, int status);
+
+private:
+    static void New(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+    // The threads helping the batches are stopped and joined when the environment is torn down.
+    static void attachThreads(v8::Isolate * isolate);
+
+private:
+    static v8::Persistent<v8::Function> constructor;
+};
+
+} // namespace quasardb
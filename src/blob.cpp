@@ -1,6 +1,11 @@
 
 #include "blob.hpp"
 #include "cluster.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 namespace quasardb
 {
@@ -12,4 +17,333 @@ void Blob::New(const v8::FunctionCallbackInfo<v8::Value> & args)
     Cluster::newObject<Blob>(args);
 }
 
+qdb_request::slice Blob::encodedContent(qdb_request * qdb_req)
+{
+    auto & content = qdb_req->input.content;
+    if (!blob_encode(content.codec, content.buffer.begin, content.buffer.size, content.encoded)) return content.buffer;
+
+    qdb_request::slice res;
+    res.begin = content.encoded.data();
+    res.size = content.encoded.size();
+    return res;
+}
+
+qdb_error_t Blob::decodeContent(qdb_request * qdb_req)
+{
+    auto & buffer = qdb_req->output.content.buffer;
+
+    // without a codec, raw contents which happen to start with the header are not mistaken for encoded ones
+    if (qdb_req->input.content.codec == blob_codec::none) return qdb_e_ok;
+
+    size_t decoded_size = 0;
+    if (!blob_is_encoded(buffer.begin, buffer.size, decoded_size)) return qdb_e_ok;
+
+    void * decoded = std::malloc(decoded_size);
+    const bool ok = decoded && blob_decode(buffer.begin, buffer.size, decoded, decoded_size);
+
+    // the encoded content is released right away, the Buffer takes ownership of the decoded one
+    qdb_release(qdb_req->handle(), buffer.begin);
+    buffer.begin = nullptr;
+    buffer.size = 0;
+
+    if (!ok)
+    {
+        std::free(decoded);
+        return decoded ? qdb_e_data_corruption : qdb_e_no_memory_local;
+    }
+
+    buffer.begin = decoded;
+    buffer.size = decoded_size;
+    qdb_req->output.buffer_malloced = true;
+    return qdb_e_ok;
+}
+
+namespace
+{
+
+// Whether a stored content, encoded or not, holds the value.
+bool stored_value_is(const void * stored, size_t stored_size, const qdb_request::slice & value)
+{
+    size_t decoded_size = 0;
+    if (!blob_is_encoded(stored, stored_size, decoded_size))
+    {
+        return (stored_size == value.size) && !std::memcmp(stored, value.begin, value.size);
+    }
+
+    if (decoded_size != value.size) return false;
+
+    std::vector<unsigned char> decoded(decoded_size);
+    return blob_decode(stored, stored_size, decoded.data(), decoded_size)
+           && !std::memcmp(decoded.data(), value.begin, value.size);
+}
+
+// The comparand as put would store it with the request codec.
+qdb_request::slice encoded_comparand(qdb_request * qdb_req, std::vector<unsigned char> & encoded)
+{
+    const auto & content = qdb_req->input.content;
+    if (!blob_encode(content.codec, content.comparand.begin, content.comparand.size, encoded)) return content.comparand;
+
+    qdb_request::slice res;
+    res.begin = encoded.data();
+    res.size = encoded.size();
+    return res;
+}
+
+// the request and the cached content are bound as the data of the microtask
+void deliverCached(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    v8::Isolate * isolate = args.GetIsolate();
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    auto data = args.Data().As<v8::Array>();
+    std::unique_ptr<qdb_request> qdb_req(
+        static_cast<qdb_request *>(data->Get(context, 0).ToLocalChecked().As<v8::External>()->Value()));
+
+    // same as Entry::processResult, the callback runs in the async context of the get
+    node::CallbackScope callback_scope(isolate, qdb_req->async_resource(isolate), qdb_req->async_context());
+
+    v8::TryCatch try_catch(isolate);
+
+    const bool timed = qdb_req->timed();
+    const auto converting = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    static const int argc = 2;
+    v8::Local<v8::Value> argv[argc] = {v8::Null(isolate), data->Get(context, 1).ToLocalChecked()};
+    if (timed) qdb_req->finish_timing(isolate, converting, 0, argv, argc);
+    qdb_req->publish_end(isolate, argv[0]);
+
+    qdb_req->callbackAsLocal()->Call(context, context->Global(), argc, argv);
+
+    if (try_catch.HasCaught())
+    {
+        node::FatalException(isolate, try_catch);
+    }
+}
+
+} // namespace
+
+bool Blob::getCached(const v8::FunctionCallbackInfo<v8::Value> & args, blob_cache & cache)
+{
+    if ((args.Length() != 1) || !args[0]->IsFunction()) return false;
+
+    Blob * b = node::ObjectWrap::Unwrap<Blob>(args.Holder());
+    assert(b);
+
+    auto content = cache.find(b->native_alias(), b->codec(), blob_cache_now());
+    if (!content) return false;
+
+    MethodMan call(args);
+    v8::Isolate * isolate = args.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    // the cached content is shared, every get hands out its own copy
+    v8::Local<v8::Object> buffer;
+    if (!node::Buffer::Copy(isolate, content->data(), content->size()).ToLocal(&buffer)) return false;
+
+    // a hit is a request which never reaches the thread pool, it is timed, is an async resource and is published on
+    // the diagnostics channels as any other get
+    std::unique_ptr<qdb_request> qdb_req(new qdb_request(b->cluster_data(), nullptr, b->native_alias()));
+    qdb_req->start_timing(call);
+    qdb_req->output.error = qdb_e_ok;
+    qdb_req->callback.Reset(isolate, args[0].As<v8::Function>());
+
+    v8::Local<v8::Array> data = v8::Array::New(isolate, 2);
+    data->Set(context, 0, v8::External::New(isolate, qdb_req.get())).Check();
+    data->Set(context, 1, buffer).Check();
+
+    // callbacks are never called synchronously, a microtask avoids the round trip through the thread pool
+    v8::Local<v8::Function> deliver;
+    if (!v8::Function::New(context, deliverCached, data).ToLocal(&deliver)) return false;
+
+    qdb_req->start_async(isolate);
+    qdb_req.release();
+
+    isolate->EnqueueMicrotask(deliver);
+    args.GetReturnValue().SetUndefined();
+    return true;
+}
+
+void Blob::fillCache(qdb_request * qdb_req, blob_cache & cache, uint64_t generation)
+{
+    // with exact expiry, the entry expiry bounds how long the content can be served, entries whose expiry is unknown
+    // are not cached
+    qdb_time_t expiry = 0;
+    if (cache.exact_expiry())
+    {
+        qdb_entry_metadata_t meta;
+        if (qdb_get_metadata(qdb_req->handle(), qdb_req->input.alias.c_str(), &meta) != qdb_e_ok) return;
+
+        if ((meta.expiry_time.tv_sec != 0) || (meta.expiry_time.tv_nsec != 0))
+        {
+            expiry = meta.expiry_time.tv_sec * 1000 + meta.expiry_time.tv_nsec / 1000000;
+        }
+    }
+
+    const auto & buffer = qdb_req->output.content.buffer;
+    cache.insert(qdb_req->input.alias, buffer.begin, buffer.size, qdb_req->input.content.codec, expiry, generation,
+        blob_cache_now());
+}
+
+void Blob::executeGetRange(qdb_request * qdb_req)
+{
+    const auto & range = qdb_req->input.content.range;
+    if ((range.offset < 0) || (range.length < 0))
+    {
+        qdb_req->output.error = qdb_e_invalid_argument;
+        return;
+    }
+
+    // the C API has no partial get: the whole content is transferred, only the part is handed to JS
+    auto & buffer = qdb_req->output.content.buffer;
+    qdb_req->output.error =
+        qdb_blob_get(qdb_req->handle(), qdb_req->input.alias.c_str(), &(buffer.begin), &(buffer.size));
+    if (qdb_req->output.error != qdb_e_ok) return;
+
+    qdb_req->output.error = decodeContent(qdb_req);
+    if (qdb_req->output.error != qdb_e_ok) return;
+
+    const void * content = buffer.begin;
+    const size_t size = buffer.size;
+    const bool malloced = qdb_req->output.buffer_malloced;
+
+    const size_t offset = std::min(static_cast<size_t>(range.offset), size);
+    const size_t length = std::min(static_cast<size_t>(range.length), size - offset);
+
+    // copied out here so that the whole content is released right away, the Buffer takes ownership of the part
+    void * part = length ? std::malloc(length) : nullptr;
+    if (part) std::memcpy(part, static_cast<const char *>(content) + offset, length);
+
+    if (malloced)
+    {
+        std::free(const_cast<void *>(content));
+    }
+    else
+    {
+        qdb_release(qdb_req->handle(), content);
+    }
+
+    buffer.begin = part;
+    buffer.size = part ? length : 0;
+    qdb_req->output.buffer_malloced = true;
+
+    if (length && !part)
+    {
+        qdb_req->output.error = qdb_e_no_memory_local;
+    }
+}
+
+void Blob::executeCompareAndSwap(qdb_request * qdb_req)
+{
+    const auto content = encodedContent(qdb_req);
+
+    std::vector<unsigned char> encoded;
+    const auto comparand = encoded_comparand(qdb_req, encoded);
+
+    auto & buffer = qdb_req->output.content.buffer;
+    qdb_req->output.error = qdb_blob_compare_and_swap(qdb_req->handle(), qdb_req->input.alias.c_str(), content.begin,
+        content.size, comparand.begin, comparand.size, qdb_req->input.expiry, &(buffer.begin), &(buffer.size));
+
+    // the stored value may be the comparand in another form, written raw or before the codec was set: the swap is tried
+    // once more against the exact stored bytes
+    if ((qdb_req->output.error == qdb_e_unmatched_content) && (qdb_req->input.content.codec != blob_codec::none)
+        && stored_value_is(buffer.begin, buffer.size, qdb_req->input.content.comparand))
+    {
+        const auto stored = static_cast<const unsigned char *>(buffer.begin);
+        std::vector<unsigned char> current(stored, stored + buffer.size);
+
+        qdb_release(qdb_req->handle(), buffer.begin);
+        buffer.begin = nullptr;
+        buffer.size = 0;
+
+        qdb_req->output.error = qdb_blob_compare_and_swap(qdb_req->handle(), qdb_req->input.alias.c_str(),
+            content.begin, content.size, current.data(), current.size(), qdb_req->input.expiry, &(buffer.begin),
+            &(buffer.size));
+    }
+
+    // the current content handed back on a mismatch is decoded as gets are
+    if (qdb_req->output.error == qdb_e_unmatched_content)
+    {
+        const qdb_error_t err = decodeContent(qdb_req);
+        if (err != qdb_e_ok) qdb_req->output.error = err;
+    }
+}
+
+void Blob::executeRemoveIf(qdb_request * qdb_req)
+{
+    std::vector<unsigned char> encoded;
+    const auto comparand = encoded_comparand(qdb_req, encoded);
+
+    qdb_req->output.error =
+        qdb_blob_remove_if(qdb_req->handle(), qdb_req->input.alias.c_str(), comparand.begin, comparand.size);
+    if ((qdb_req->output.error != qdb_e_unmatched_content) || (qdb_req->input.content.codec == blob_codec::none))
+    {
+        return;
+    }
+
+    // same as compareAndSwap, the removal is tried once more against the exact stored bytes when they hold the value
+    const void * stored = nullptr;
+    qdb_size_t stored_size = 0;
+    if (qdb_blob_get(qdb_req->handle(), qdb_req->input.alias.c_str(), &stored, &stored_size) != qdb_e_ok) return;
+
+    if (stored_value_is(stored, stored_size, qdb_req->input.content.comparand))
+    {
+        qdb_req->output.error = qdb_blob_remove_if(qdb_req->handle(), qdb_req->input.alias.c_str(), stored, stored_size);
+    }
+
+    qdb_release(qdb_req->handle(), stored);
+}
+
+void Blob::getCompression(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    MethodMan call(args);
+
+    Blob * b = call.nativeHolder<Blob>();
+    assert(b);
+
+    call.template setReturnValue<v8::Integer>(static_cast<int>(b->codec()));
+}
+
+void Blob::setCompression(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    MethodMan call(args);
+
+    if (args.Length() != 1)
+    {
+        call.throwException("Wrong number of arguments");
+        return;
+    }
+
+    ArgsEater argsEater(call);
+
+    auto codec = argsEater.eatInteger<int>();
+    if (!codec.second || !blob_codec_valid(codec.first))
+    {
+        call.throwException("setCompression expects one of the COMPRESSION_* constants");
+        return;
+    }
+
+    Blob * b = call.nativeHolder<Blob>();
+    assert(b);
+
+    b->_codec = codec.first;
+}
+
+void Blob::processCompareAndSwapResult(uv_work_t * req, int status)
+{
+    processResult<2>(req, status,
+        [&](v8::Isolate * isolate, qdb_request * qdb_req)
+        {
+            // on a mismatch the current content is returned along with the error, ownership goes to the Buffer
+            const auto error_code = processErrorCode(isolate, status, qdb_req);
+            const auto result_data = ((status >= 0) && (qdb_req->output.content.buffer.size > 0u)
+                                         && ((qdb_req->output.error == qdb_e_ok)
+                                             || (qdb_req->output.error == qdb_e_unmatched_content)))
+                                         ? qdb_req->make_node_buffer(isolate).ToLocalChecked()
+                                         : node::Buffer::New(isolate, 0).ToLocalChecked();
+
+            return make_value_array(error_code, result_data);
+        });
+}
+
 } // namespace quasardb
\ No newline at end of file
@@ -27,6 +27,7 @@ public:
 private:
     Blob(cluster_data_ptr cd, const char * alias)
         : ExpirableEntry<Blob>(cd, alias)
+        , _codec(-1)
     {
     }
     virtual ~Blob(void)
@@ -39,12 +40,103 @@ public:
         ExpirableEntry<Blob>::Init(exports, "Blob",
             [](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "put", put);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "update", update);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "get", get);
+                detail::SetOperation(tpl, "put", put);
+                detail::SetOperation(tpl, "update", update);
+                detail::SetOperation(tpl, "get", get);
+                detail::SetOperation(tpl, "getRange", getRange);
+                detail::SetOperation(tpl, "compareAndSwap", compareAndSwap);
+                detail::SetOperation(tpl, "getAndUpdate", getAndUpdate);
+                detail::SetOperation(tpl, "getAndRemove", getAndRemove);
+                detail::SetOperation(tpl, "removeIf", removeIf);
+                detail::SetOperation(tpl, "getCompression", getCompression);
+                detail::SetOperation(tpl, "setCompression", setCompression);
+
+                // writes through the entry functions must invalidate the blob cache as well
+                detail::SetOperation(tpl, "remove", remove);
+                detail::SetOperation(tpl, "expiresAt", expiresAt);
+                detail::SetOperation(tpl, "expiresFromNow", expiresFromNow);
             });
     }
 
+private:
+    // Same as Entry::queue_work, for operations modifying the blob. Binds the codec the content is to be written with,
+    // resolved on the JS thread: the blob's own codec if set, the cluster's otherwise.
+    //
+    // The cached content, if any, is invalidated right away and once more when the write completes, so that gets
+    // issued while the write is in flight do not fill the cache with the previous content.
+    template <typename F, typename... Params>
+    static void queue_write_work(
+        const v8::FunctionCallbackInfo<v8::Value> & args, F f, uv_after_work_cb after_work_cb, Params... p)
+    {
+        Blob * b = node::ObjectWrap::Unwrap<Blob>(args.Holder());
+        assert(b);
+
+        const blob_codec codec = b->codec();
+
+        blob_cache_ptr cache = b->cache();
+        if (cache) cache->invalidate(b->native_alias());
+
+        ExpirableEntry<Blob>::queue_work(
+            args,
+            [codec, cache, f](qdb_request * qdb_req)
+            {
+                qdb_req->input.content.codec = codec;
+                f(qdb_req);
+                if (cache) cache->invalidate(qdb_req->input.alias);
+            },
+            after_work_cb, p...);
+    }
+
+    // Same as Entry::queue_work, for operations reading the blob. Binds the codec, contents are only decoded when one
+    // is set.
+    template <typename F, typename... Params>
+    static void queue_read_work(
+        const v8::FunctionCallbackInfo<v8::Value> & args, F f, uv_after_work_cb after_work_cb, Params... p)
+    {
+        Blob * b = node::ObjectWrap::Unwrap<Blob>(args.Holder());
+        assert(b);
+
+        const blob_codec codec = b->codec();
+
+        ExpirableEntry<Blob>::queue_work(
+            args,
+            [codec, f](qdb_request * qdb_req)
+            {
+                qdb_req->input.content.codec = codec;
+                f(qdb_req);
+            },
+            after_work_cb, p...);
+    }
+
+    blob_cache_ptr cache(void)
+    {
+        cluster_data_ptr cd = cluster_data();
+        return cd ? cd->get_blob_cache() : nullptr;
+    }
+
+    // Calls back with a copy of the cached content, from a microtask rather than synchronously.
+    // Returns false when the content is not cached.
+    static bool getCached(const v8::FunctionCallbackInfo<v8::Value> & args, blob_cache & cache);
+
+    // Caches the content a get retrieved, along with its codec and, with exact expiry, the entry expiry, on the worker
+    // thread.
+    static void fillCache(qdb_request * qdb_req, blob_cache & cache, uint64_t generation);
+
+    blob_codec codec(void)
+    {
+        if (_codec >= 0) return static_cast<blob_codec>(_codec);
+
+        cluster_data_ptr cd = cluster_data();
+        return cd ? cd->get_blob_codec() : blob_codec::none;
+    }
+
+    // Encodes the input buffer with the request codec, returns what is to be stored.
+    static qdb_request::slice encodedContent(qdb_request * qdb_req);
+
+    // Replaces an encoded output buffer by its decoded content when the request has a codec. Raw contents, and any
+    // content read without a codec, are left untouched.
+    static qdb_error_t decodeContent(qdb_request * qdb_req);
+
 public:
     // put a new entry, with an optional expiry time
     // :desc: Sets blob's content but fails if the blob already exists. See also update().
@@ -53,12 +145,13 @@ public:
     // callback(err) (function) - A callback or anonymous function with error parameter.
     static void put(const v8::FunctionCallbackInfo<v8::Value> & args)
     {
-        ExpirableEntry<Blob>::queue_work(
+        Blob::queue_write_work(
             args,
             [](qdb_request * qdb_req)
             {
-                qdb_req->output.error = qdb_blob_put(qdb_req->handle(), qdb_req->input.alias.c_str(),
-                    qdb_req->input.content.buffer.begin, qdb_req->input.content.buffer.size, qdb_req->input.expiry);
+                const auto content = Blob::encodedContent(qdb_req);
+                qdb_req->output.error = qdb_blob_put(qdb_req->handle(), qdb_req->input.alias.c_str(), content.begin,
+                    content.size, qdb_req->input.expiry);
             },
             ExpirableEntry<Blob>::processVoidResult, &ArgsEaterBinder::buffer, &ArgsEaterBinder::expiry);
     }
@@ -70,36 +163,175 @@ public:
     // callback(err) (function) - A callback or anonymous function with error parameter.
     static void update(const v8::FunctionCallbackInfo<v8::Value> & args)
     {
-        ExpirableEntry<Blob>::queue_work(
+        Blob::queue_write_work(
             args,
             [](qdb_request * qdb_req)
             {
-                qdb_req->output.error = qdb_blob_update(qdb_req->handle(), qdb_req->input.alias.c_str(),
-                    qdb_req->input.content.buffer.begin, qdb_req->input.content.buffer.size, qdb_req->input.expiry);
+                const auto content = Blob::encodedContent(qdb_req);
+                qdb_req->output.error = qdb_blob_update(qdb_req->handle(), qdb_req->input.alias.c_str(), content.begin,
+                    content.size, qdb_req->input.expiry);
             },
             ExpirableEntry<Blob>::processVoidResult, &ArgsEaterBinder::buffer, &ArgsEaterBinder::expiry);
     }
 
     // return the alias content
-    // :desc: Retrieves the blob's content, passes to callback as data.
+    // :desc: Retrieves the blob's content, passes to callback as data. Served from the cluster blob cache when enabled.
     // :args: callback(err, data) (function) - A callback or anonymous function with error and data parameters.
     static void get(const v8::FunctionCallbackInfo<v8::Value> & args)
     {
-        ExpirableEntry<Blob>::queue_work(
+        Blob * b = node::ObjectWrap::Unwrap<Blob>(args.Holder());
+        assert(b);
+
+        blob_cache_ptr cache = b->cache();
+        if (cache && getCached(args, *cache)) return;
+
+        const uint64_t generation = cache ? cache->generation() : 0;
+
+        Blob::queue_read_work(
             args,
-            [](qdb_request * qdb_req)
+            [cache, generation](qdb_request * qdb_req)
             {
                 qdb_req->output.error = qdb_blob_get(qdb_req->handle(), qdb_req->input.alias.c_str(),
                     &(qdb_req->output.content.buffer.begin), &(qdb_req->output.content.buffer.size));
+                if (qdb_req->output.error == qdb_e_ok) qdb_req->output.error = Blob::decodeContent(qdb_req);
+                if (cache && (qdb_req->output.error == qdb_e_ok)) Blob::fillCache(qdb_req, *cache, generation);
             },
             ExpirableEntry<Blob>::processBufferResult, &ArgsEaterBinder::buffer);
     }
 
+    // :desc: Retrieves part of the blob's content, passes to callback as data. The part is clipped to the blob size.
+    // The C API has no partial get: the whole content is transferred and only the part is kept, there is no transfer
+    // saving for non-streamed blobs. Use createReadStream with start and end on streamed blobs to fetch only the chunks
+    // holding the part.
+    // :args: offset (Number) - The offset of the first byte to retrieve.
+    // length (Number) - The number of bytes to retrieve.
+    // callback(err, data) (function) - A callback or anonymous function with error and data parameters.
+    static void getRange(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Blob::queue_read_work(
+            args, Blob::executeGetRange, ExpirableEntry<Blob>::processBufferResult, &ArgsEaterBinder::byteRange);
+    }
+
+    // :desc: Atomically replaces the blob's content if it matches the comparand. When it does not, the callback gets
+    // an E_UNMATCHED_CONTENT error and the current content as data. With a codec, the content is encoded as put does
+    // and the comparand matches the stored value whether it was encoded or not.
+    // :args: content (Buffer) - The new content of the blob.
+    // comparand (Buffer) - The content the blob must have to be replaced.
+    // expiry_time (Date) - An optional Date with the absolute time at which the entry should expire.
+    // callback(err, data) (function) - A callback or anonymous function with error and data parameters.
+    static void compareAndSwap(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Blob::queue_write_work(args, Blob::executeCompareAndSwap, Blob::processCompareAndSwapResult,
+            &ArgsEaterBinder::buffer, &ArgsEaterBinder::comparand, &ArgsEaterBinder::expiry);
+    }
+
+    // :desc: Atomically updates the blob's content and passes the previous one to callback as data.
+    // :args: content (Buffer) - The new content of the blob.
+    // expiry_time (Date) - An optional Date with the absolute time at which the entry should expire.
+    // callback(err, data) (function) - A callback or anonymous function with error and data parameters.
+    static void getAndUpdate(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Blob::queue_write_work(
+            args,
+            [](qdb_request * qdb_req)
+            {
+                const auto content = Blob::encodedContent(qdb_req);
+                qdb_req->output.error = qdb_blob_get_and_update(qdb_req->handle(), qdb_req->input.alias.c_str(),
+                    content.begin, content.size, qdb_req->input.expiry, &(qdb_req->output.content.buffer.begin),
+                    &(qdb_req->output.content.buffer.size));
+                if (qdb_req->output.error == qdb_e_ok) qdb_req->output.error = Blob::decodeContent(qdb_req);
+            },
+            ExpirableEntry<Blob>::processBufferResult, &ArgsEaterBinder::buffer, &ArgsEaterBinder::expiry);
+    }
+
+    // :desc: Atomically removes the blob and passes its content to callback as data.
+    // :args: callback(err, data) (function) - A callback or anonymous function with error and data parameters.
+    static void getAndRemove(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Blob::queue_write_work(
+            args,
+            [](qdb_request * qdb_req)
+            {
+                qdb_req->output.error = qdb_blob_get_and_remove(qdb_req->handle(), qdb_req->input.alias.c_str(),
+                    &(qdb_req->output.content.buffer.begin), &(qdb_req->output.content.buffer.size));
+                if (qdb_req->output.error == qdb_e_ok) qdb_req->output.error = Blob::decodeContent(qdb_req);
+            },
+            ExpirableEntry<Blob>::processBufferResult);
+    }
+
+    // :desc: Atomically removes the blob if its content matches the comparand, fails with E_UNMATCHED_CONTENT
+    // otherwise. With a codec, the comparand matches the stored value whether it was encoded or not.
+    // :args: comparand (Buffer) - The content the blob must have to be removed.
+    // callback(err) (function) - A callback or anonymous function with error parameter.
+    static void removeIf(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Blob::queue_write_work(
+            args, Blob::executeRemoveIf, ExpirableEntry<Blob>::processVoidResult, &ArgsEaterBinder::comparand);
+    }
+
+    // :desc: Removes the blob.
+    // :args: callback(err) (function) - A callback function with error parameter
+    static void remove(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Blob::queue_write_work(
+            args,
+            [](qdb_request * qdb_req)
+            { qdb_req->output.error = qdb_remove(qdb_req->handle(), qdb_req->input.alias.c_str()); },
+            ExpirableEntry<Blob>::processVoidResult, &ArgsEaterBinder::none);
+    }
+
+    // :desc: Sets the expiration time for the blob at a given Date.
+    // :args: expiry_time (Date) - A Date at which the blob expires.
+    // callback(err) (function) - A callback or anonymous function with error parameter.
+    static void expiresAt(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Blob::queue_write_work(
+            args,
+            [](qdb_request * qdb_req)
+            {
+                qdb_req->output.error =
+                    qdb_expires_at(qdb_req->handle(), qdb_req->input.alias.c_str(), qdb_req->input.expiry);
+            },
+            ExpirableEntry<Blob>::processVoidResult, &ArgsEaterBinder::expiry);
+    }
+
+    // :desc: Sets the expiration time for the blob as a number of seconds from call time.
+    // :args: seconds (int) - A number of seconds from call time at which the blob expires.
+    // callback(err) (function) - A callback or anonymous function with error parameter.
+    static void expiresFromNow(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Blob::queue_write_work(
+            args,
+            [](qdb_request * qdb_req)
+            {
+                qdb_req->output.error = qdb_expires_from_now(qdb_req->handle(), qdb_req->input.alias.c_str(),
+                    static_cast<qdb_int_t>(qdb_req->input.content.value));
+            },
+            ExpirableEntry<Blob>::processVoidResult, &ArgsEaterBinder::integer);
+    }
+
+    // :desc: Returns the compression the blob is written with, one of the COMPRESSION_* constants.
+    // :returns: The blob's compression, or the cluster's if the blob has none
+    static void getCompression(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+    // :desc: Sets the compression the blob is written with, instead of the cluster's. Reads decode any compression, as
+    // long as one is set.
+    // :args: compression (Integer) - One of the COMPRESSION_* constants
+    static void setCompression(const v8::FunctionCallbackInfo<v8::Value> & args);
+
 private:
     static void New(const v8::FunctionCallbackInfo<v8::Value> & args);
 
+    static void executeGetRange(qdb_request * qdb_req);
+    static void executeCompareAndSwap(qdb_request * qdb_req);
+    static void executeRemoveIf(qdb_request * qdb_req);
+    static void processCompareAndSwapResult(uv_work_t * req, int status);
+
 private:
     static v8::Persistent<v8::Function> constructor;
+
+    // one of the blob_codec values, or negative to use the cluster's
+    int _codec;
 };
 
 } // namespace quasardb
@@ -0,0 +1,138 @@
+#include "blob_cache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace quasardb
+{
+
+blob_cache::blob_cache(size_t max_bytes, qdb_time_t max_age, bool exact_expiry)
+    : _max_bytes(max_bytes)
+    , _max_age(max_age)
+    , _exact_expiry(exact_expiry)
+    , _bytes(0)
+    , _generation(0)
+    , _floor(0)
+    , _hits(0)
+    , _misses(0)
+    , _evictions(0)
+{
+}
+
+std::shared_ptr<const std::string> blob_cache::find(const std::string & alias, blob_codec codec, qdb_time_t now)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // a content cached with another codec is left for the gets made with it
+    auto it = _entries.find(alias);
+    if ((it == _entries.end()) || (it->second.codec != codec))
+    {
+        ++_misses;
+        return nullptr;
+    }
+
+    if (now >= it->second.valid_until)
+    {
+        erase(it);
+        ++_misses;
+        return nullptr;
+    }
+
+    _lru.splice(_lru.begin(), _lru, it->second.lru);
+    ++_hits;
+    return it->second.content;
+}
+
+uint64_t blob_cache::generation() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _generation;
+}
+
+void blob_cache::insert(const std::string & alias,
+    const void * content,
+    size_t size,
+    blob_codec codec,
+    qdb_time_t expiry,
+    uint64_t generation,
+    qdb_time_t now)
+{
+    qdb_time_t valid_until = std::numeric_limits<qdb_time_t>::max();
+    if (expiry > 0) valid_until = expiry;
+    if (_max_age > 0) valid_until = std::min(valid_until, now + _max_age);
+
+    if ((size > _max_bytes) || (valid_until <= now)) return;
+
+    // copied before taking the lock
+    auto copy = std::make_shared<const std::string>(static_cast<const char *>(content), size);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // invalidated while the get was in flight, the content may be stale
+    auto invalidated = _invalidated.find(alias);
+    if (((invalidated != _invalidated.end()) ? invalidated->second : _floor) > generation) return;
+
+    auto it = _entries.find(alias);
+    if (it != _entries.end()) erase(it);
+
+    while (!_lru.empty() && (_bytes + size > _max_bytes))
+    {
+        erase(_entries.find(_lru.back()));
+        ++_evictions;
+    }
+
+    _lru.push_front(alias);
+
+    entry e;
+    e.content = std::move(copy);
+    e.codec = codec;
+    e.valid_until = valid_until;
+    e.lru = _lru.begin();
+    _entries.emplace(alias, std::move(e));
+
+    _bytes += size;
+}
+
+void blob_cache::invalidate(const std::string & alias)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _invalidated[alias] = ++_generation;
+    if (_invalidated.size() > max_invalidated)
+    {
+        _invalidated.clear();
+        _floor = _generation;
+    }
+
+    auto it = _entries.find(alias);
+    if (it != _entries.end()) erase(it);
+}
+
+blob_cache::statistics blob_cache::stats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    statistics res;
+    res.hits = _hits;
+    res.misses = _misses;
+    res.evictions = _evictions;
+    res.entries = _entries.size();
+    res.bytes = _bytes;
+    res.max_bytes = _max_bytes;
+    return res;
+}
+
+void blob_cache::erase(std::unordered_map<std::string, entry>::iterator it)
+{
+    _bytes -= it->second.content->size();
+    _lru.erase(it->second.lru);
+    _entries.erase(it);
+}
+
+qdb_time_t blob_cache_now()
+{
+    using namespace std::chrono;
+    return static_cast<qdb_time_t>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace quasardb
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "blob_codec.hpp"
+#include <qdb/client.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace quasardb
+{
+
+// Read-through cache of blob contents, keyed by alias, bounded in bytes and evicted least recently used first.
+// Contents are cached as the get which read them returned them, decoded or not, along with the codec it was made
+// with: they are only served to gets made with the same codec.
+//
+// Contents are looked up and invalidated from the JS thread, and inserted from the worker thread once a get
+// completes. Invalidations are stamped from a counter, a get only fills the cache when its alias was not invalidated
+// since the get was queued, so that a get racing with a local write cannot cache the previous content. The stamps of
+// the aliases are forgotten past max_invalidated, the gets queued before are then not cached.
+//
+// Writes from other clients are not seen, max_age bounds how long a content can be served without being read again.
+class blob_cache
+{
+public:
+    struct statistics
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        size_t entries;
+        size_t bytes;
+        size_t max_bytes;
+    };
+
+public:
+    // max_age in milliseconds, 0 for no limit. With exact_expiry, the expiry of the entries is looked up when they are
+    // cached, at the cost of a round trip per miss, otherwise entries expiring on the cluster are served up to max_age.
+    blob_cache(size_t max_bytes, qdb_time_t max_age, bool exact_expiry);
+
+public:
+    // Returns the content when cached and fresh, nullptr otherwise. Times are milliseconds since epoch.
+    std::shared_ptr<const std::string> find(const std::string & alias, blob_codec codec, qdb_time_t now);
+
+    // the generation a get queued now is to be inserted with
+    uint64_t generation() const;
+
+    bool exact_expiry() const
+    {
+        return _exact_expiry;
+    }
+
+    // expiry is the absolute expiry of the entry in milliseconds since epoch, 0 when it does not expire
+    void insert(const std::string & alias,
+        const void * content,
+        size_t size,
+        blob_codec codec,
+        qdb_time_t expiry,
+        uint64_t generation,
+        qdb_time_t now);
+
+    void invalidate(const std::string & alias);
+
+    statistics stats() const;
+
+private:
+    struct entry
+    {
+        std::shared_ptr<const std::string> content;
+        blob_codec codec;
+        qdb_time_t valid_until;
+        std::list<std::string>::iterator lru;
+    };
+
+    void erase(std::unordered_map<std::string, entry>::iterator it);
+
+private:
+    const size_t _max_bytes;
+    const qdb_time_t _max_age;
+    const bool _exact_expiry;
+
+    mutable std::mutex _mutex;
+
+    std::unordered_map<std::string, entry> _entries;
+
+    // most recently used first
+    std::list<std::string> _lru;
+
+    size_t _bytes;
+
+    static const size_t max_invalidated = 65536;
+
+    // the stamp of the last invalidation of the aliases, aliases which are not listed were last invalidated at _floor
+    // at most
+    std::unordered_map<std::string, uint64_t> _invalidated;
+    uint64_t _generation;
+    uint64_t _floor;
+
+    uint64_t _hits;
+    uint64_t _misses;
+    uint64_t _evictions;
+};
+
+using blob_cache_ptr = std::shared_ptr<blob_cache>;
+
+// milliseconds since epoch, as the cache expects them
+qdb_time_t blob_cache_now();
+
+} // namespace quasardb
@@ -0,0 +1,108 @@
+#include "blob_codec.hpp"
+#include <zlib.h>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace quasardb
+{
+namespace detail
+{
+
+// magic (4 bytes), codec (1 byte), reserved (3 bytes, zero), original size (8 bytes, little endian)
+static const unsigned char header_magic[4] = {0x89, 'Q', 'D', 'Z'};
+static const size_t header_size = 16;
+
+static void write_header(unsigned char * header, blob_codec codec, uint64_t size)
+{
+    std::memcpy(header, header_magic, sizeof(header_magic));
+    header[4] = static_cast<unsigned char>(codec);
+    header[5] = header[6] = header[7] = 0;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        header[8 + i] = static_cast<unsigned char>(size >> (8 * i));
+    }
+}
+
+static bool read_header(const unsigned char * content, size_t size, blob_codec & codec, uint64_t & decoded_size)
+{
+    if ((size <= header_size) || std::memcmp(content, header_magic, sizeof(header_magic))) return false;
+    if (!blob_codec_valid(content[4]) || (content[4] == static_cast<unsigned char>(blob_codec::none))) return false;
+    if (content[5] || content[6] || content[7]) return false;
+
+    codec = static_cast<blob_codec>(content[4]);
+    decoded_size = 0;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        decoded_size |= static_cast<uint64_t>(content[8 + i]) << (8 * i);
+    }
+
+    return decoded_size <= std::numeric_limits<uLong>::max();
+}
+
+} // namespace detail
+
+bool blob_codec_valid(int codec)
+{
+    return (codec == static_cast<int>(blob_codec::none)) || (codec == static_cast<int>(blob_codec::deflate));
+}
+
+bool blob_encode(blob_codec codec, const void * content, size_t size, std::vector<unsigned char> & encoded)
+{
+    encoded.clear();
+    if ((codec != blob_codec::deflate) || !size || (size > std::numeric_limits<uLong>::max())) return false;
+
+    // favour speed, the contents we target (JSON, protobuf) compress well at the lowest level
+    uLongf compressed_size = compressBound(static_cast<uLong>(size));
+    encoded.resize(detail::header_size + compressed_size);
+
+    if (compress2(encoded.data() + detail::header_size, &compressed_size, static_cast<const Bytef *>(content),
+            static_cast<uLong>(size), Z_BEST_SPEED)
+        != Z_OK)
+    {
+        encoded.clear();
+        return false;
+    }
+
+    if (detail::header_size + compressed_size >= size)
+    {
+        encoded.clear();
+        return false;
+    }
+
+    detail::write_header(encoded.data(), codec, size);
+    encoded.resize(detail::header_size + compressed_size);
+    return true;
+}
+
+bool blob_is_encoded(const void * content, size_t size, size_t & decoded_size)
+{
+    blob_codec codec;
+    uint64_t original_size;
+    if (!content || !detail::read_header(static_cast<const unsigned char *>(content), size, codec, original_size))
+    {
+        return false;
+    }
+
+    decoded_size = static_cast<size_t>(original_size);
+    return true;
+}
+
+bool blob_decode(const void * content, size_t size, void * decoded, size_t decoded_size)
+{
+    blob_codec codec;
+    uint64_t original_size;
+    if (!detail::read_header(static_cast<const unsigned char *>(content), size, codec, original_size)
+        || (original_size != decoded_size))
+    {
+        return false;
+    }
+
+    uLongf length = static_cast<uLongf>(decoded_size);
+    const int res = uncompress(static_cast<Bytef *>(decoded), &length,
+        static_cast<const Bytef *>(content) + detail::header_size, static_cast<uLong>(size - detail::header_size));
+
+    return (res == Z_OK) && (length == decoded_size);
+}
+
+} // namespace quasardb
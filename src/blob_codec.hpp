@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace quasardb
+{
+
+// Client side codecs for blob contents. The values are exported to JS as COMPRESSION_* constants and stored in the
+// codec byte of the header, new codecs take the next values.
+enum class blob_codec
+{
+    none = 0,
+    deflate = 1
+};
+
+bool blob_codec_valid(int codec);
+
+// Encoded contents start with a header naming the codec and the size of the original content, so that encoded and raw
+// values can coexist and be read back without knowing how they were written.
+//
+// Encodes the content into `encoded`. Returns false, and leaves `encoded` empty, when the codec is none or when
+// encoding does not make the content smaller, in which case the content is to be stored raw.
+// Meant to be run on the worker thread, does not touch V8.
+bool blob_encode(blob_codec codec, const void * content, size_t size, std::vector<unsigned char> & encoded);
+
+// Returns true and sets `decoded_size` when the content starts with a valid header.
+bool blob_is_encoded(const void * content, size_t size, size_t & decoded_size);
+
+// Decodes a content for which blob_is_encoded returned true into `decoded`, which must hold `decoded_size` bytes.
+// Returns false when the content is corrupted.
+bool blob_decode(const void * content, size_t size, void * decoded, size_t decoded_size);
+
+} // namespace quasardb
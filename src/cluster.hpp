@@ -1,5 +1,6 @@
 #pragma once
 
+#include "batch.hpp"
 #include "blob.hpp"
 #include "cluster_data.hpp"
 #include "error.hpp"
@@ -30,6 +31,8 @@ public:
         , _user_private_key_file{user_private_key_file}
         , _cluster_public_key_file{cluster_public_key_file}
         , _timeout{60000}
+        , _blob_codec{blob_codec::none}
+        , _not_found_as_null{false}
     {
     }
 
@@ -60,6 +63,7 @@ public:
         // Prototype
         NODE_SET_PROTOTYPE_METHOD(tpl, "connect", connect);
 
+        NODE_SET_PROTOTYPE_METHOD(tpl, "batch", batch);
         NODE_SET_PROTOTYPE_METHOD(tpl, "blob", blob);
         NODE_SET_PROTOTYPE_METHOD(tpl, "integer", integer);
         NODE_SET_PROTOTYPE_METHOD(tpl, "tag", tag);
@@ -71,6 +75,18 @@ public:
 
         NODE_SET_PROTOTYPE_METHOD(tpl, "getTimeout", getTimeout);
         NODE_SET_PROTOTYPE_METHOD(tpl, "setTimeout", setTimeout);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "getBlobCompression", getBlobCompression);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "setBlobCompression", setBlobCompression);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "getNotFoundAsNull", getNotFoundAsNull);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "setNotFoundAsNull", setNotFoundAsNull);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "enableBlobCache", enableBlobCache);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "disableBlobCache", disableBlobCache);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "blobCacheStats", blobCacheStats);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "enableStats", enableStats);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "disableStats", disableStats);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "stats", stats);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "enableConversionWatchdog", enableConversionWatchdog);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "disableConversionWatchdog", disableConversionWatchdog);
         NODE_SET_PROTOTYPE_METHOD(tpl, "suffix", suffix);
 
         AddEntryType(exports, "ENTRY_UNINITIALIZED", qdb_entry_uninitialized);
@@ -422,6 +438,13 @@ public:
         objectFactory<Blob>(args);
     }
 
+    // :desc: Creates a Batch, to run operations on many entries at once. No query is performed at this point.
+    // :returns: the Batch
+    static void batch(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        objectFactory<Batch>(args);
+    }
+
     // :desc: Creates an Integer associated with the specified alias. No query is performed at this point.
     // :args: alias (String) - the alias of the integer in the database.
     // :returns: the Integer
@@ -555,6 +578,350 @@ public:
         }
     }
 
+    // :desc: Returns the compression blobs are written with by default, one of the COMPRESSION_* constants
+    // :returns: The default blob compression
+
+    static void getBlobCompression(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        call.template setReturnValue<v8::Integer>(static_cast<int>(c->_blob_codec));
+    }
+
+    // :desc: Sets the compression blobs are written with, unless set on the blob itself. Reads detect the compression.
+    // :args: compression (Integer) - One of the COMPRESSION_* constants
+
+    static void setBlobCompression(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        if (args.Length() != 1)
+        {
+            call.throwException("Wrong number of arguments");
+            return;
+        }
+
+        ArgsEater argsEater(call);
+
+        auto codec = argsEater.eatInteger<int>();
+        if (!codec.second || !blob_codec_valid(codec.first))
+        {
+            call.throwException("setBlobCompression expects one of the COMPRESSION_* constants");
+            return;
+        }
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        c->_blob_codec = static_cast<blob_codec>(codec.first);
+
+        cluster_data_ptr cd = c->data();
+        if (cd)
+        {
+            cd->set_blob_codec(c->_blob_codec);
+        }
+    }
+
+    // :desc: Returns whether reads of missing entries call back with null rather than an E_ALIAS_NOT_FOUND error
+    // :returns: True if missing entries are null results
+
+    static void getNotFoundAsNull(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        call.template setReturnValue<v8::Boolean>(c->_not_found_as_null);
+    }
+
+    // :desc: When enabled, calls returning a value (get, getAndRemove, getAndUpdate, getExpiry, getMetadata, ...) call
+    // back with a null error and a null value when the entry does not exist, rather than with an E_ALIAS_NOT_FOUND
+    // error. Other calls are not affected.
+    // :args: enabled (Boolean) - True to return missing entries as null results
+
+    static void setNotFoundAsNull(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        if ((args.Length() != 1) || !args[0]->IsBoolean())
+        {
+            call.throwException("setNotFoundAsNull expects a boolean");
+            return;
+        }
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        c->_not_found_as_null = args[0]->BooleanValue(args.GetIsolate());
+
+        cluster_data_ptr cd = c->data();
+        if (cd)
+        {
+            cd->set_not_found_as_null(c->_not_found_as_null);
+        }
+    }
+
+    // :desc: Caches the content of blobs read with get, so that reading them again does not query the cluster. The
+    // cache is invalidated by writes made through this cluster object only.
+    // :args: options (Object) - maxBytes, the size of the cache in bytes (16 MiB by default), maxAge, the number
+    // of milliseconds a content can be served from the cache (no limit by default), and exactExpiry, whether to look
+    // up the expiry of the entries on every miss so as to never serve them past it (false by default).
+
+    static void enableBlobCache(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        double max_bytes = 16.0 * 1024.0 * 1024.0;
+        double max_age = 0.0;
+        bool exact_expiry = false;
+
+        if (args.Length() > 0)
+        {
+            ArgsEater argsEater(call);
+
+            auto options = argsEater.eatObject();
+            if (!options.second)
+            {
+                call.throwException("enableBlobCache expects an options object");
+                return;
+            }
+
+            v8::Isolate * isolate = args.GetIsolate();
+            auto context = isolate->GetCurrentContext();
+
+            auto bytes = options.first->Get(context, property_key(isolate, key::max_bytes)).ToLocalChecked();
+            auto age = options.first->Get(context, property_key(isolate, key::max_age)).ToLocalChecked();
+            auto expiry = options.first->Get(context, property_key(isolate, key::exact_expiry)).ToLocalChecked();
+
+            if (bytes->IsNumber()) max_bytes = bytes.As<v8::Number>()->Value();
+            if (age->IsNumber()) max_age = age.As<v8::Number>()->Value();
+            exact_expiry = expiry->BooleanValue(isolate);
+        }
+
+        if (!(max_bytes >= 1.0) || !(max_age >= 0.0))
+        {
+            call.throwException("maxBytes must be positive and maxAge must not be negative");
+            return;
+        }
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        c->_blob_cache = std::make_shared<blob_cache>(
+            static_cast<size_t>(max_bytes), static_cast<qdb_time_t>(max_age), exact_expiry);
+
+        cluster_data_ptr cd = c->data();
+        if (cd)
+        {
+            cd->set_blob_cache(c->_blob_cache);
+        }
+    }
+
+    // :desc: Disables and empties the blob cache.
+
+    static void disableBlobCache(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        c->_blob_cache.reset();
+
+        cluster_data_ptr cd = c->data();
+        if (cd)
+        {
+            cd->set_blob_cache(nullptr);
+        }
+    }
+
+    // :desc: Returns the blob cache counters: hits, misses, evictions, entries, bytes and maxBytes.
+    // :returns: the counters, or null when the cache is disabled
+
+    static void blobCacheStats(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        v8::Isolate * isolate = args.GetIsolate();
+        if (!c->_blob_cache)
+        {
+            args.GetReturnValue().SetNull();
+            return;
+        }
+
+        const auto stats = c->_blob_cache->stats();
+
+        auto context = isolate->GetCurrentContext();
+        auto obj = v8::Object::New(isolate);
+        auto set = [&](key k, double value)
+        { obj->Set(context, property_key(isolate, k), v8::Number::New(isolate, value)).FromJust(); };
+
+        set(key::hits, static_cast<double>(stats.hits));
+        set(key::misses, static_cast<double>(stats.misses));
+        set(key::evictions, static_cast<double>(stats.evictions));
+        set(key::entries, static_cast<double>(stats.entries));
+        set(key::bytes, static_cast<double>(stats.bytes));
+        set(key::max_bytes, static_cast<double>(stats.max_bytes));
+
+        args.GetReturnValue().Set(obj);
+    }
+
+    // :desc: Records, per operation, the latency of the requests made through this cluster object, from the call to
+    // the start on a worker thread, on the worker thread and to convert the result, as well as calls, errors and
+    // bytes transferred. Enabling them again resets them.
+
+    static void enableStats(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        c->_op_stats = std::make_shared<op_stats>();
+
+        cluster_data_ptr cd = c->data();
+        if (cd)
+        {
+            cd->set_op_stats(c->_op_stats);
+        }
+    }
+
+    // :desc: Stops recording and discards the statistics.
+
+    static void disableStats(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        c->_op_stats.reset();
+
+        cluster_data_ptr cd = c->data();
+        if (cd)
+        {
+            cd->set_op_stats(nullptr);
+        }
+    }
+
+    // :desc: Returns the statistics of the operations called since they were enabled, keyed by operation, such as
+    // Blob.get. Each has calls, errors, bytesIn, bytesOut and the queue, execute and convert latencies in
+    // microseconds: count, mean, p50, p90, p99 and max.
+    // :returns: the statistics, or null when they are disabled
+
+    static void stats(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        v8::Isolate * isolate = args.GetIsolate();
+        if (!c->_op_stats)
+        {
+            args.GetReturnValue().SetNull();
+            return;
+        }
+
+        auto context = isolate->GetCurrentContext();
+        auto set = [&](v8::Local<v8::Object> obj, key k, double value)
+        { obj->Set(context, property_key(isolate, k), v8::Number::New(isolate, value)).FromJust(); };
+
+        auto histogram = [&](const latency_histogram & h)
+        {
+            const auto summary = h.summarize();
+
+            auto obj = v8::Object::New(isolate);
+            set(obj, key::count, static_cast<double>(summary.count));
+            set(obj, key::mean, summary.mean);
+            set(obj, key::p50, summary.p50);
+            set(obj, key::p90, summary.p90);
+            set(obj, key::p99, summary.p99);
+            set(obj, key::maximum, summary.max);
+            return obj;
+        };
+
+        auto res = v8::Object::New(isolate);
+        c->_op_stats->for_each(
+            [&](const std::string & name, const op_counters & counters)
+            {
+                auto obj = v8::Object::New(isolate);
+                set(obj, key::calls, static_cast<double>(counters.calls.load(std::memory_order_relaxed)));
+                set(obj, key::errors, static_cast<double>(counters.errors.load(std::memory_order_relaxed)));
+                set(obj, key::bytes_in, static_cast<double>(counters.bytes_in.load(std::memory_order_relaxed)));
+                set(obj, key::bytes_out, static_cast<double>(counters.bytes_out.load(std::memory_order_relaxed)));
+                obj->Set(context, property_key(isolate, key::queue), histogram(counters.queue)).FromJust();
+                obj->Set(context, property_key(isolate, key::execute), histogram(counters.execute)).FromJust();
+                obj->Set(context, property_key(isolate, key::convert), histogram(counters.convert)).FromJust();
+
+                res->Set(context,
+                       v8::String::NewFromUtf8(isolate, name.c_str(), v8::NewStringType::kNormal,
+                           static_cast<int>(name.size()))
+                           .ToLocalChecked(),
+                       obj)
+                    .FromJust();
+            });
+
+        args.GetReturnValue().Set(res);
+    }
+
+    // :desc: Reports the calls made through this cluster object which block the event loop while converting their
+    // arguments or their result for thresholdMs milliseconds or more. The callback is called right after the
+    // conversion with an Object: operation (such as Blob.get), alias, phase ("arguments" or "result"), count (the
+    // number of elements of the largest array or Buffer converted) and duration in milliseconds.
+    // :args: thresholdMs (Number) - The minimum duration reported, in milliseconds.
+    // callback(report) (function) - The function called with the reports.
+
+    static void enableConversionWatchdog(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        if ((args.Length() != 2) || !args[0]->IsNumber() || !args[1]->IsFunction() ||
+            !(args[0].As<v8::Number>()->Value() >= 0.0))
+        {
+            call.throwException("enableConversionWatchdog expects a threshold in milliseconds and a callback");
+            return;
+        }
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        const auto threshold_micros = static_cast<uint64_t>(args[0].As<v8::Number>()->Value() * 1000.0);
+        c->_conversion_watchdog =
+            std::make_shared<conversion_watchdog>(args.GetIsolate(), threshold_micros, args[1].As<v8::Function>());
+
+        cluster_data_ptr cd = c->data();
+        if (cd)
+        {
+            cd->set_conversion_watchdog(c->_conversion_watchdog);
+        }
+    }
+
+    // :desc: Stops reporting the calls blocking the event loop.
+
+    static void disableConversionWatchdog(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        Cluster * c = call.nativeHolder<Cluster>();
+        assert(c);
+
+        c->_conversion_watchdog.reset();
+
+        cluster_data_ptr cd = c->data();
+        if (cd)
+        {
+            cd->set_conversion_watchdog(nullptr);
+        }
+    }
+
 public:
     const std::string & uri(void) const
     {
@@ -582,7 +949,11 @@ private:
         {
             std::unique_lock<std::mutex> lock(_data_mutex);
             res = _data = std::make_shared<cluster_data>(
-                _uri, _user_private_key_file, _cluster_public_key_file, _timeout, on_success, on_error);
+                _uri, _user_private_key_file, _cluster_public_key_file, _timeout, _blob_codec, on_success, on_error);
+            _data->set_blob_cache(_blob_cache);
+            _data->set_not_found_as_null(_not_found_as_null);
+            _data->set_op_stats(_op_stats);
+            _data->set_conversion_watchdog(_conversion_watchdog);
         }
 
         return res;
@@ -596,6 +967,11 @@ private:
     mutable std::mutex _data_mutex;
 
     int _timeout;
+    blob_codec _blob_codec;
+    blob_cache_ptr _blob_cache;
+    op_stats_ptr _op_stats;
+    conversion_watchdog_ptr _conversion_watchdog;
+    bool _not_found_as_null;
     cluster_data_ptr _data;
 
     static v8::Persistent<v8::Function> constructor;
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "blob_cache.hpp"
+#include "blob_codec.hpp"
+#include "conversion_watchdog.hpp"
+#include "op_stats.hpp"
 #include <qdb/client.h>
 #include <qdb/prefix.h>
 
@@ -29,12 +33,14 @@ public:
         std::string user_private_key_file,
         std::string cluster_public_key_file,
         int timeout,
+        blob_codec codec,
         v8::Local<v8::Function> os,
         v8::Local<v8::Function> oe)
         : _uri{std::move(uri)}
         , _user_private_key_file{std::move(user_private_key_file)}
         , _cluster_public_key_file{std::move(cluster_public_key_file)}
         , _timeout{timeout}
+        , _blob_codec{codec}
     {
         bindCallbacks(os, oe);
     }
@@ -121,6 +127,62 @@ public:
         return !_handle ? qdb_e_ok : qdb_option_set_timeout(static_cast<qdb_handle_t>(_handle.get()), _timeout);
     }
 
+    // only read and written from the JS thread, requests get the codec bound when they are queued
+    blob_codec get_blob_codec(void) const
+    {
+        return _blob_codec;
+    }
+
+    void set_blob_codec(blob_codec codec)
+    {
+        _blob_codec = codec;
+    }
+
+    // null when blob caching is disabled
+    blob_cache_ptr get_blob_cache(void) const
+    {
+        return _blob_cache;
+    }
+
+    void set_blob_cache(blob_cache_ptr cache)
+    {
+        _blob_cache = std::move(cache);
+    }
+
+    // null when statistics are disabled, only read and written from the JS thread, requests keep the one they started
+    // with
+    const op_stats_ptr & get_op_stats(void) const
+    {
+        return _op_stats;
+    }
+
+    void set_op_stats(op_stats_ptr stats)
+    {
+        _op_stats = std::move(stats);
+    }
+
+    // null when disabled, only read and written from the JS thread, requests keep the one they started with
+    const conversion_watchdog_ptr & get_conversion_watchdog(void) const
+    {
+        return _conversion_watchdog;
+    }
+
+    void set_conversion_watchdog(conversion_watchdog_ptr watchdog)
+    {
+        _conversion_watchdog = std::move(watchdog);
+    }
+
+    // only read and written from the JS thread, requests read it when they call back
+    bool not_found_as_null(void) const
+    {
+        return _not_found_as_null;
+    }
+
+    void set_not_found_as_null(bool enabled)
+    {
+        _not_found_as_null = enabled;
+    }
+
     qdb_error_t prefix_get(const std::string & prefix, qdb_int_t max_count)
     {
         const char ** results = NULL;
@@ -136,6 +198,11 @@ private:
     const std::string _user_private_key_file;
     const std::string _cluster_public_key_file;
     int _timeout;
+    blob_codec _blob_codec;
+    blob_cache_ptr _blob_cache;
+    op_stats_ptr _op_stats;
+    conversion_watchdog_ptr _conversion_watchdog;
+    bool _not_found_as_null = false;
     v8::Persistent<v8::Function> _on_success;
     v8::Persistent<v8::Function> _on_error;
 
@@ -0,0 +1,100 @@
+#include "conversion_watchdog.hpp"
+#include "keys.hpp"
+#include "op_stats.hpp"
+#include <algorithm>
+
+namespace quasardb
+{
+
+conversion_watchdog::conversion_watchdog(
+    v8::Isolate * isolate, uint64_t threshold_micros, v8::Local<v8::Function> callback)
+    : _threshold_micros(threshold_micros)
+    , _callback(isolate, callback)
+{
+}
+
+conversion_watchdog::~conversion_watchdog()
+{
+    _callback.Reset();
+}
+
+void conversion_watchdog::report(v8::Isolate * isolate,
+    const char * phase,
+    uint32_t operation,
+    const std::string & alias,
+    double count,
+    uint64_t micros) const
+{
+    v8::HandleScope scope(isolate);
+    auto context = isolate->GetCurrentContext();
+
+    auto string = [isolate](const char * s, size_t size)
+    {
+        return v8::String::NewFromUtf8(isolate, s, v8::NewStringType::kNormal, static_cast<int>(size))
+            .ToLocalChecked();
+    };
+
+    const std::string & name = op_stats::operation_name(operation);
+
+    auto report = v8::Object::New(isolate);
+    report->Set(context, property_key(isolate, key::operation), string(name.c_str(), name.size())).FromJust();
+    report->Set(context, property_key(isolate, key::alias), string(alias.c_str(), alias.size())).FromJust();
+    report->Set(context, property_key(isolate, key::phase), string(phase, std::char_traits<char>::length(phase)))
+        .FromJust();
+    report->Set(context, property_key(isolate, key::count), v8::Number::New(isolate, count)).FromJust();
+    report->Set(context, property_key(isolate, key::duration),
+              v8::Number::New(isolate, static_cast<double>(micros) / 1000.0))
+        .FromJust();
+
+    static const int argc = 1;
+    v8::Local<v8::Value> argv[argc] = {report};
+
+    // an exception thrown by the callback is reported as the ones thrown by the callbacks of the requests, it must not
+    // escape into the call being made
+    v8::TryCatch try_catch(isolate);
+
+    v8::Local<v8::Function> callback = v8::Local<v8::Function>::New(isolate, _callback);
+    callback->Call(context, context->Global(), argc, argv);
+
+    if (try_catch.HasCaught())
+    {
+        node::FatalException(isolate, try_catch);
+    }
+}
+
+double conversion_watchdog::element_count(const v8::Local<v8::Value> * values, size_t count)
+{
+    double res = 0.0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const v8::Local<v8::Value> & v = values[i];
+        if (v.IsEmpty()) continue;
+
+        if (v->IsArray())
+        {
+            res = std::max(res, static_cast<double>(v.As<v8::Array>()->Length()));
+        }
+        else if (v->IsTypedArray())
+        {
+            res = std::max(res, static_cast<double>(v.As<v8::TypedArray>()->Length()));
+        }
+    }
+
+    return res;
+}
+
+double conversion_watchdog::element_count(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    double res = 0.0;
+
+    for (int i = 0; i < args.Length(); ++i)
+    {
+        v8::Local<v8::Value> v = args[i];
+        res = std::max(res, element_count(&v, 1));
+    }
+
+    return res;
+}
+
+} // namespace quasardb
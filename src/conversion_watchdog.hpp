@@ -0,0 +1,50 @@
+#pragma once
+
+#include <node.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace quasardb
+{
+
+// Reports the calls whose conversions block the JS thread for longer than a threshold: the conversion of the
+// arguments of the call to the request, and of the result of the request to the arguments of the callback.
+//
+// Reports are made to a JS callback, synchronously once the conversion is over. Only used from the JS thread.
+class conversion_watchdog
+{
+public:
+    conversion_watchdog(v8::Isolate * isolate, uint64_t threshold_micros, v8::Local<v8::Function> callback);
+    ~conversion_watchdog();
+
+    conversion_watchdog(const conversion_watchdog &) = delete;
+    conversion_watchdog & operator=(const conversion_watchdog &) = delete;
+
+public:
+    bool exceeds(uint64_t micros) const
+    {
+        return micros >= _threshold_micros;
+    }
+
+    // Calls the callback with {operation, alias, phase, count, duration}. count is the number of elements of the
+    // largest array converted, duration is in milliseconds.
+    void report(v8::Isolate * isolate,
+        const char * phase,
+        uint32_t operation,
+        const std::string & alias,
+        double count,
+        uint64_t micros) const;
+
+    // Number of elements of the largest array, typed array or Buffer among the values.
+    static double element_count(const v8::Local<v8::Value> * values, size_t count);
+    static double element_count(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+private:
+    const uint64_t _threshold_micros;
+    v8::Persistent<v8::Function> _callback;
+};
+
+using conversion_watchdog_ptr = std::shared_ptr<conversion_watchdog>;
+
+} // namespace quasardb
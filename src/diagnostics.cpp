@@ -0,0 +1,67 @@
+#include "diagnostics.hpp"
+#include "keys.hpp"
+#include <array>
+
+namespace quasardb
+{
+
+namespace
+{
+
+std::array<v8::Persistent<v8::Object>, static_cast<size_t>(diagnostics_channel::channel_count)> channels;
+
+v8::Local<v8::Object> channel_of(v8::Isolate * isolate, diagnostics_channel channel)
+{
+    return v8::Local<v8::Object>::New(isolate, channels[static_cast<size_t>(channel)]);
+}
+
+} // namespace
+
+void SetDiagnosticsChannels(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    v8::Isolate * isolate = args.GetIsolate();
+
+    if ((args.Length() != 2) || !args[0]->IsObject() || !args[1]->IsObject())
+    {
+        isolate->ThrowException(v8::Exception::TypeError(
+            v8::String::NewFromUtf8(isolate, "setDiagnosticsChannels expects two channels", v8::NewStringType::kNormal)
+                .ToLocalChecked()));
+        return;
+    }
+
+    channels[static_cast<size_t>(diagnostics_channel::request_start)].Reset(isolate, args[0].As<v8::Object>());
+    channels[static_cast<size_t>(diagnostics_channel::request_end)].Reset(isolate, args[1].As<v8::Object>());
+}
+
+bool has_subscribers(v8::Isolate * isolate, diagnostics_channel channel)
+{
+    if (channels[static_cast<size_t>(channel)].IsEmpty()) return false;
+
+    auto context = isolate->GetCurrentContext();
+
+    v8::Local<v8::Value> subscribed;
+    if (!channel_of(isolate, channel)->Get(context, property_key(isolate, key::has_subscribers)).ToLocal(&subscribed))
+    {
+        return false;
+    }
+
+    return subscribed->BooleanValue(isolate);
+}
+
+void publish(v8::Isolate * isolate, diagnostics_channel channel, v8::Local<v8::Object> message)
+{
+    if (channels[static_cast<size_t>(channel)].IsEmpty()) return;
+
+    auto context = isolate->GetCurrentContext();
+    v8::Local<v8::Object> c = channel_of(isolate, channel);
+
+    v8::Local<v8::Value> f;
+    if (!c->Get(context, property_key(isolate, key::publish)).ToLocal(&f) || !f->IsFunction()) return;
+
+    // subscribers throwing are reported by diagnostics_channel itself
+    static const int argc = 1;
+    v8::Local<v8::Value> argv[argc] = {message};
+    f.As<v8::Function>()->Call(context, c, argc, argv);
+}
+
+} // namespace quasardb
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <node.h>
+
+namespace quasardb
+{
+
+// The diagnostics_channel channels requests are published on, set by lib/diagnostics.js. Only used from the JS thread.
+enum class diagnostics_channel
+{
+    // {operation, alias} when a request is made
+    request_start,
+    // the same object with error and duration, before the callback of the request is called
+    request_end,
+
+    // not a channel, number of channels
+    channel_count
+};
+
+// Exported as setDiagnosticsChannels(start, end), the channels are Channel objects.
+void SetDiagnosticsChannels(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+// False when the channels are not set.
+bool has_subscribers(v8::Isolate * isolate, diagnostics_channel channel);
+
+void publish(v8::Isolate * isolate, diagnostics_channel channel, v8::Local<v8::Object> message);
+
+} // namespace quasardb
@@ -28,6 +28,23 @@ template <typename... T>
 namespace detail
 {
 
+// NODE_SET_PROTOTYPE_METHOD, with the operation the calls are accounted to in the statistics of the cluster as the
+// data of the method, see op_stats.
+inline void SetOperation(v8::Local<v8::FunctionTemplate> recv, const char * name, v8::FunctionCallback callback)
+{
+    v8::Isolate * isolate = v8::Isolate::GetCurrent();
+    v8::HandleScope handle_scope(isolate);
+
+    v8::Local<v8::Signature> s = v8::Signature::New(isolate, recv);
+    v8::Local<v8::Value> operation = v8::Integer::NewFromUnsigned(isolate, op_stats::register_operation(name));
+    v8::Local<v8::FunctionTemplate> t = v8::FunctionTemplate::New(isolate, callback, operation, s);
+
+    v8::Local<v8::String> fn_name =
+        v8::String::NewFromUtf8(isolate, name, v8::NewStringType::kInternalized).ToLocalChecked();
+    t->SetClassName(fn_name);
+    recv->PrototypeTemplate()->Set(fn_name, t);
+}
+
 static void callback_wrapper(uv_work_t * req)
 {
     static_cast<qdb_request *>(req->data)->execute();
@@ -130,14 +147,19 @@ private:
         assert(pthis);
 
         qdb_request * qdb_req = new qdb_request(pthis->_cluster_data, f, pthis->native_alias());
+        qdb_req->start_timing(call);
 
         ArgsEaterBinder eaterBinder(call);
         eaterBinder.eatThem(*qdb_req, p...);
 
+        qdb_req->arguments_converted(call);
+
         uv_work_t * req = nullptr;
 
         if (eaterBinder.bindCallback(*qdb_req))
         {
+            qdb_req->start_async(call.args().GetIsolate());
+
             req = new uv_work_t();
             req->data = qdb_req;
         }
@@ -314,16 +336,16 @@ public:
         InitConstructorOnly(exports, className,
             [init](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "alias", Entry<Derivate>::alias);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "remove", Entry<Derivate>::remove);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "attachTag", Entry<Derivate>::attachTag);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "attachTags", Entry<Derivate>::attachTags);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "getMetadata", Entry<Derivate>::getMetadata);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "getTags", Entry<Derivate>::getTags);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "hasTag", Entry<Derivate>::hasTag);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "hasTags", Entry<Derivate>::hasTags);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "detachTag", Entry<Derivate>::detachTag);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "detachTags", Entry<Derivate>::detachTags);
+                detail::SetOperation(tpl, "alias", Entry<Derivate>::alias);
+                detail::SetOperation(tpl, "remove", Entry<Derivate>::remove);
+                detail::SetOperation(tpl, "attachTag", Entry<Derivate>::attachTag);
+                detail::SetOperation(tpl, "attachTags", Entry<Derivate>::attachTags);
+                detail::SetOperation(tpl, "getMetadata", Entry<Derivate>::getMetadata);
+                detail::SetOperation(tpl, "getTags", Entry<Derivate>::getTags);
+                detail::SetOperation(tpl, "hasTag", Entry<Derivate>::hasTag);
+                detail::SetOperation(tpl, "hasTags", Entry<Derivate>::hasTags);
+                detail::SetOperation(tpl, "detachTag", Entry<Derivate>::detachTag);
+                detail::SetOperation(tpl, "detachTags", Entry<Derivate>::detachTags);
 
                 init(tpl);
             });
@@ -340,6 +362,7 @@ public:
         tpl->SetClassName(v8::String::NewFromUtf8(isolate, className, v8::NewStringType::kNormal).ToLocalChecked());
         tpl->InstanceTemplate()->SetInternalFieldCount(Entry<Derivate>::FieldsCount);
 
+        op_stats::class_scope registering(className);
         init(tpl);
 
         auto maybe_function = tpl->GetFunction(isolate->GetCurrentContext());
@@ -422,19 +445,35 @@ protected:
         return Error::MakeError(isolate, req->output.error); // req->output.error);
     }
 
+    // a missing entry is a null value rather than an error when the cluster asks for it, see setNotFoundAsNull
+    static bool notFoundAsNull(int status, const qdb_request * req)
+    {
+        return (status >= 0) && (req->output.error == qdb_e_alias_not_found) && req->not_found_as_null();
+    }
+
     template <size_t Argc, typename Proc>
     static void processResult(uv_work_t * req, int status, Proc process)
     {
         v8::Isolate * isolate = v8::Isolate::GetCurrent();
         v8::HandleScope scope(isolate);
 
-        v8::TryCatch try_catch(isolate);
-
         qdb_request * qdb_req = static_cast<qdb_request *>(req->data);
         assert(qdb_req);
 
+        // the conversion and the callback run in the async context of the call, the queued ticks and microtasks run
+        // once the callback returns
+        node::CallbackScope callback_scope(isolate, qdb_req->async_resource(isolate), qdb_req->async_context());
+
+        v8::TryCatch try_catch(isolate);
+
+        const bool timed = qdb_req->timed();
+        const auto converting = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
         std::array<v8::Local<v8::Value>, Argc> args = process(isolate, qdb_req);
 
+        if (timed) qdb_req->finish_timing(isolate, converting, status, args.data(), args.size());
+        qdb_req->publish_end(isolate, args[0]);
+
         processCallAndCleanUp(isolate, try_catch, req, qdb_req, static_cast<unsigned int>(args.size()), args.data());
     }
 
@@ -446,6 +485,8 @@ public:
             {
                 // don't free the buffer qdb_req->output.content.buffer.begin
                 // we handed over ownership in make_node_buffer
+                if (notFoundAsNull(status, qdb_req)) return make_value_array(v8::Null(isolate), v8::Null(isolate));
+
                 const auto error_code = processErrorCode(isolate, status, qdb_req);
                 const auto result_data =
                     ((status >= 0) && (qdb_req->output.error == qdb_e_ok) && (qdb_req->output.content.buffer.size > 0u))
@@ -499,12 +540,80 @@ public:
             });
     }
 
+    // aliases packed by qdb_request::pack_aliases, as a Buffer and the Uint32Array of their offsets in the Buffer
+    static void processPackedStringResult(uv_work_t * req, int status)
+    {
+        processResult<3>(req, status,
+            [&](v8::Isolate * isolate, qdb_request * qdb_req)
+            {
+                auto error_code = processErrorCode(isolate, status, qdb_req);
+
+                const bool ok = (qdb_req->output.error == qdb_e_ok) && (status >= 0);
+                const auto & offsets = qdb_req->output.packed_offsets;
+
+                uint32_t * offsets_data = nullptr;
+                auto offsets_array =
+                    detail::NewTypedArray<v8::Uint32Array>(isolate, ok ? offsets.size() : 0, offsets_data);
+                if (ok) std::copy(offsets.cbegin(), offsets.cend(), offsets_data);
+
+                v8::Local<v8::Object> buffer;
+                if (!(ok ? qdb_req->make_node_buffer(isolate) : node::Buffer::New(isolate, static_cast<size_t>(0u)))
+                         .ToLocal(&buffer))
+                {
+                    return make_value_array(Error::MakeError(isolate, qdb_e_no_memory_local),
+                        v8::Local<v8::Value>(v8::Null(isolate)), v8::Local<v8::Value>(offsets_array));
+                }
+
+                return make_value_array(error_code, v8::Local<v8::Value>(buffer), v8::Local<v8::Value>(offsets_array));
+            });
+    }
+
+    // page of aliases and continuation token, null once the enumeration is over
+    static void processKeyPageResult(uv_work_t * req, int status)
+    {
+        processResult<3>(req, status,
+            [&](v8::Isolate * isolate, qdb_request * qdb_req)
+            {
+                auto error_code = processErrorCode(isolate, status, qdb_req);
+                if ((qdb_req->output.error != qdb_e_ok) || (status < 0))
+                {
+                    return make_value_array(error_code, v8::Array::New(isolate, 0), v8::Null(isolate));
+                }
+
+                const auto & aliases = qdb_req->output.page.aliases;
+                const auto & token = qdb_req->output.page.token;
+
+                auto context = isolate->GetCurrentContext();
+                v8::Local<v8::Array> array = v8::Array::New(isolate, static_cast<int>(aliases.size()));
+                for (size_t i = 0; i < aliases.size(); ++i)
+                {
+                    array->Set(context, static_cast<uint32_t>(i),
+                        v8::String::NewFromUtf8(isolate, aliases[i].c_str(), v8::NewStringType::kNormal,
+                            static_cast<int>(aliases[i].size()))
+                            .ToLocalChecked());
+                }
+
+                v8::Local<v8::Value> next = v8::Null(isolate);
+                if (!token.empty())
+                {
+                    v8::Local<v8::Object> buffer;
+                    if (!node::Buffer::Copy(isolate, token.data(), token.size()).ToLocal(&buffer))
+                    {
+                        return make_value_array(Error::MakeError(isolate, qdb_e_no_memory_local),
+                            v8::Array::New(isolate, 0), v8::Null(isolate));
+                    }
+                    next = buffer;
+                }
+
+                return make_value_array(error_code, array, next);
+            });
+    }
+
     static void query_set_rows(
         v8::Isolate * isolate, const qdb_query_result_t * result, v8::Local<v8::Object> & final_result)
     {
-        auto rows_prop = v8::String::NewFromUtf8(isolate, "rows", v8::NewStringType::kNormal).ToLocalChecked();
-        auto rows_count_prop =
-            v8::String::NewFromUtf8(isolate, "row_count", v8::NewStringType::kNormal).ToLocalChecked();
+        auto rows_prop = property_key(isolate, key::rows);
+        auto rows_count_prop = property_key(isolate, key::row_count);
 
         const auto column_count = result->column_count;
         const auto row_count = result->row_count;
@@ -568,10 +677,8 @@ public:
     static void query_set_columns_names(
         v8::Isolate * isolate, const qdb_query_result_t * result, v8::Local<v8::Object> & final_result)
     {
-        auto columns_names_prop =
-            v8::String::NewFromUtf8(isolate, "column_names", v8::NewStringType::kNormal).ToLocalChecked();
-        auto columns_count_prop =
-            v8::String::NewFromUtf8(isolate, "column_count", v8::NewStringType::kNormal).ToLocalChecked();
+        auto columns_names_prop = property_key(isolate, key::column_names);
+        auto columns_count_prop = property_key(isolate, key::column_count);
 
         const auto column_count = result->column_count;
         v8::Local<v8::Array> column_names = v8::Array::New(isolate, static_cast<int>(column_count));
@@ -593,10 +700,8 @@ public:
             // Some queries don't return any result.
             return {};
         }
-        auto scanned_point_count_prop =
-            v8::String::NewFromUtf8(isolate, "scanned_point_count", v8::NewStringType::kNormal).ToLocalChecked();
-        auto error_msg_prop =
-            v8::String::NewFromUtf8(isolate, "error_message", v8::NewStringType::kNormal).ToLocalChecked();
+        auto scanned_point_count_prop = property_key(isolate, key::scanned_point_count);
+        auto error_msg_prop = property_key(isolate, key::error_message);
 
         final_result->Set(isolate->GetCurrentContext(), scanned_point_count_prop,
             v8::Number::New(isolate, result->scanned_point_count));
@@ -641,6 +746,8 @@ public:
         processResult<2>(req, status,
             [&](v8::Isolate * isolate, qdb_request * qdb_req)
             {
+                if (notFoundAsNull(status, qdb_req)) return make_value_array(v8::Null(isolate), v8::Null(isolate));
+
                 const auto error_code = processErrorCode(isolate, status, qdb_req);
                 auto result_data = ((status >= 0) && (qdb_req->output.error == qdb_e_ok))
                                        ? v8::Number::New(isolate, static_cast<double>(qdb_req->output.content.value))
@@ -669,6 +776,8 @@ public:
         processResult<2>(req, status,
             [&](v8::Isolate * isolate, qdb_request * qdb_req)
             {
+                if (notFoundAsNull(status, qdb_req)) return make_value_array(v8::Null(isolate), v8::Null(isolate));
+
                 const auto error_code = processErrorCode(isolate, status, qdb_req);
                 if ((status >= 0) && (qdb_req->output.error == qdb_e_ok) && (qdb_req->output.content.value > 0))
                 {
@@ -692,6 +801,8 @@ public:
         processResult<2>(req, status,
             [&](v8::Isolate * isolate, qdb_request * qdb_req)
             {
+                if (notFoundAsNull(status, qdb_req)) return make_value_array(v8::Null(isolate), v8::Null(isolate));
+
                 const auto error_code = processErrorCode(isolate, status, qdb_req);
                 if ((status < 0) || (qdb_req->output.error != qdb_e_ok))
                 {
@@ -708,14 +819,10 @@ public:
 
                 auto meta = v8::Object::New(isolate);
 
-                meta->Set(isolate->GetCurrentContext(),
-                    v8::String::NewFromUtf8(isolate, "reference", v8::NewStringType::kNormal).ToLocalChecked(),
-                    reference);
-                meta->Set(isolate->GetCurrentContext(),
-                    v8::String::NewFromUtf8(isolate, "type", v8::NewStringType::kNormal).ToLocalChecked(),
+                meta->Set(isolate->GetCurrentContext(), property_key(isolate, key::reference), reference);
+                meta->Set(isolate->GetCurrentContext(), property_key(isolate, key::type),
                     v8::Integer::New(isolate, qdb_req->output.content.entry_metadata.type));
-                meta->Set(isolate->GetCurrentContext(),
-                    v8::String::NewFromUtf8(isolate, "size", v8::NewStringType::kNormal).ToLocalChecked(),
+                meta->Set(isolate->GetCurrentContext(), property_key(isolate, key::size),
                     v8::Number::New(isolate, static_cast<double>(qdb_req->output.content.entry_metadata.size)));
 
                 {
@@ -728,9 +835,7 @@ public:
                         return make_value_array(error_code, meta);
                     }
 
-                    meta->Set(isolate->GetCurrentContext(),
-                        v8::String::NewFromUtf8(isolate, "modification_time", v8::NewStringType::kNormal)
-                            .ToLocalChecked(),
+                    meta->Set(isolate->GetCurrentContext(), property_key(isolate, key::modification_time),
                         (millis > 0) ? maybe_date.ToLocalChecked() : v8::Local<v8::Value>(v8::Undefined(isolate)));
                 }
 
@@ -744,8 +849,7 @@ public:
                         return make_value_array(error_code, meta);
                     }
 
-                    meta->Set(isolate->GetCurrentContext(),
-                        v8::String::NewFromUtf8(isolate, "expiry_time", v8::NewStringType::kNormal).ToLocalChecked(),
+                    meta->Set(isolate->GetCurrentContext(), property_key(isolate, key::expiry_time),
                         (millis > 0) ? maybe_date.ToLocalChecked() : v8::Local<v8::Value>(v8::Undefined(isolate)));
                 }
 
@@ -758,6 +862,8 @@ public:
         processResult<2>(req, status,
             [&](v8::Isolate * isolate, qdb_request * qdb_req)
             {
+                if (notFoundAsNull(status, qdb_req)) return make_value_array(v8::Null(isolate), v8::Null(isolate));
+
                 const auto error_code = processErrorCode(isolate, status, qdb_req);
                 auto result_data = ((status >= 0) && (qdb_req->output.error == qdb_e_ok))
                                        ? v8::Integer::New(isolate, qdb_req->output.content.entry_type)
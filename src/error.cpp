@@ -1,8 +1,27 @@
 #include "error.hpp"
+#include <unordered_map>
 
 namespace quasardb
 {
 
 v8::Persistent<v8::Function> Error::constructor;
+v8::Persistent<v8::ObjectTemplate> Error::instance_template;
+
+v8::Local<v8::String> Error::cachedMessage(v8::Isolate * isolate, qdb_error_t err)
+{
+    // only used from the JS thread, there are few error codes and their messages never change
+    static std::unordered_map<qdb_error_t, v8::Eternal<v8::String>> messages;
+
+    auto it = messages.find(err);
+    if (it == messages.end())
+    {
+        // the string returned by qdb_error is static it is therefore safe and efficient to do this
+        v8::Local<v8::String> message =
+            v8::String::NewFromUtf8(isolate, qdb_error(err), v8::NewStringType::kInternalized).ToLocalChecked();
+        it = messages.emplace(err, v8::Eternal<v8::String>(isolate, message)).first;
+    }
+
+    return it->second.Get(isolate);
+}
 
 } // namespace quasardb
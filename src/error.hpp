@@ -153,6 +153,7 @@ public:
         if (maybe_function.IsEmpty()) return;
 
         constructor.Reset(isolate, maybe_function.ToLocalChecked());
+        instance_template.Reset(isolate, tpl->InstanceTemplate());
         exports->Set(isolate->GetCurrentContext(),
             v8::String::NewFromUtf8(isolate, "Error", v8::NewStringType::kNormal).ToLocalChecked(),
             maybe_function.ToLocalChecked());
@@ -206,14 +207,23 @@ public:
     }
 
 public:
+    // Errors are built from the instance template rather than through the constructor, which skips the call into
+    // New and the conversion of its argument. They are instances of Error all the same.
     static v8::Local<v8::Object> MakeError(v8::Isolate * isolate, qdb_error_t err)
     {
-        static const int argc = 1;
-        v8::Local<v8::Value> argv[argc] = {v8::Number::New(isolate, err)};
-        v8::Local<v8::Function> cons = v8::Local<v8::Function>::New(isolate, constructor);
-        return cons->NewInstance(isolate->GetCurrentContext(), 1, argv).ToLocalChecked();
+        v8::Local<v8::ObjectTemplate> tpl = v8::Local<v8::ObjectTemplate>::New(isolate, instance_template);
+        v8::Local<v8::Object> obj = tpl->NewInstance(isolate->GetCurrentContext()).ToLocalChecked();
+
+        Error * e = new Error(err);
+        e->Wrap(obj);
+
+        return obj;
     }
 
+private:
+    // The message of an error code, converted once and kept for the lifetime of the isolate.
+    static v8::Local<v8::String> cachedMessage(v8::Isolate * isolate, qdb_error_t err);
+
 private:
     template <typename F>
     static void accessor(const v8::FunctionCallbackInfo<v8::Value> & args, F f)
@@ -276,11 +286,7 @@ public:
         Error::accessor(args,
             [](const v8::FunctionCallbackInfo<v8::Value> & args, Error * e)
             {
-                // the string returned by qdb_error is static it is therefore safe and efficient to do this
-                v8::Isolate * isolate = args.GetIsolate();
-                args.GetReturnValue().Set(
-                    v8::String::NewFromUtf8(isolate, qdb_error(e->_error), v8::NewStringType::kNormal)
-                        .ToLocalChecked());
+                args.GetReturnValue().Set(cachedMessage(args.GetIsolate(), e->_error));
             });
     }
 
@@ -303,6 +309,7 @@ private:
     const qdb_error_t _error;
 
     static v8::Persistent<v8::Function> constructor;
+    static v8::Persistent<v8::ObjectTemplate> instance_template;
 };
 
 } // namespace quasardb
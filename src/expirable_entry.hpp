@@ -25,13 +25,13 @@ public:
         Entry<Derivate>::Init(exports, className,
             [init](v8::Local<v8::FunctionTemplate> tpl)
             {
-                // call init function of derivate
-                init(tpl);
+                // add our expiry functions
+                detail::SetOperation(tpl, "expiresAt", ExpirableEntry<Derivate>::expiresAt);
+                detail::SetOperation(tpl, "expiresFromNow", ExpirableEntry<Derivate>::expiresFromNow);
+                detail::SetOperation(tpl, "getExpiry", ExpirableEntry<Derivate>::getExpiry);
 
-                // add our expiry functions then hand over to entry
-                NODE_SET_PROTOTYPE_METHOD(tpl, "expiresAt", ExpirableEntry<Derivate>::expiresAt);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "expiresFromNow", ExpirableEntry<Derivate>::expiresFromNow);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "getExpiry", ExpirableEntry<Derivate>::getExpiry);
+                // call init function of derivate last, so that it can override any of the entry functions
+                init(tpl);
             });
     }
 
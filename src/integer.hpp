@@ -39,11 +39,11 @@ public:
         ExpirableEntry<Integer>::Init(exports, "Integer",
             [](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "put", Integer::put);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "update", Integer::update);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "get", Integer::get);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "remove", Integer::remove);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "add", Integer::add);
+                detail::SetOperation(tpl, "put", Integer::put);
+                detail::SetOperation(tpl, "update", Integer::update);
+                detail::SetOperation(tpl, "get", Integer::get);
+                detail::SetOperation(tpl, "remove", Integer::remove);
+                detail::SetOperation(tpl, "add", Integer::add);
             });
     }
 
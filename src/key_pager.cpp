@@ -0,0 +1,154 @@
+#include "key_pager.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace quasardb
+{
+
+namespace
+{
+
+// Pending lookups are stored as a kind byte followed by the NUL terminated lookup, the last one is the next to run.
+// Exact lookups only check the alias equal to the lookup, which narrower lookups do not match.
+const char lookup_all = 'a';
+const char lookup_exact = 'x';
+
+struct lookup
+{
+    char kind;
+    std::string value;
+};
+
+bool parse_token(const void * token, size_t size, std::vector<lookup> & pending)
+{
+    const char * p = static_cast<const char *>(token);
+    const char * end = p + size;
+
+    while (p != end)
+    {
+        const char kind = *p++;
+        if ((kind != lookup_all) && (kind != lookup_exact)) return false;
+
+        const char * nul = static_cast<const char *>(std::memchr(p, '\0', static_cast<size_t>(end - p)));
+        if (!nul) return false;
+
+        pending.push_back({kind, std::string(p, nul)});
+        p = nul + 1;
+    }
+
+    return true;
+}
+
+std::string make_token(const std::vector<lookup> & pending)
+{
+    std::string token;
+
+    for (const auto & l : pending)
+    {
+        token.push_back(l.kind);
+        token.append(l.value);
+        token.push_back('\0');
+    }
+
+    return token;
+}
+
+} // namespace
+
+qdb_error_t key_pager::page(qdb_handle_t handle,
+    const std::string & root,
+    const void * token,
+    size_t token_size,
+    size_t page_size,
+    std::vector<std::string> & aliases,
+    std::string & next_token) const
+{
+    if (page_size == 0) return qdb_e_invalid_argument;
+
+    std::vector<lookup> pending;
+    if (token_size == 0)
+    {
+        pending.push_back({lookup_all, root});
+    }
+    else if (!parse_token(token, token_size, pending))
+    {
+        return qdb_e_invalid_argument;
+    }
+
+    aliases.clear();
+
+    while (!pending.empty() && (aliases.size() < page_size))
+    {
+        const lookup & next = pending.back();
+
+        if (next.kind == lookup_exact)
+        {
+            qdb_entry_metadata_t meta;
+            const qdb_error_t err = qdb_get_metadata(handle, next.value.c_str(), &meta);
+            if ((err != qdb_e_ok) && (err != qdb_e_alias_not_found)) return err;
+
+            if (err == qdb_e_ok) aliases.push_back(next.value);
+            pending.pop_back();
+            continue;
+        }
+
+        qdb_uint_t matches = 0;
+        qdb_error_t err = count(handle, next.value.c_str(), &matches);
+        if ((err != qdb_e_ok) && (err != qdb_e_alias_not_found)) return err;
+
+        if (matches == 0)
+        {
+            pending.pop_back();
+            continue;
+        }
+
+        const size_t room = page_size - aliases.size();
+        if (matches <= room)
+        {
+            const char ** results = nullptr;
+            size_t result_count = 0;
+
+            // one more alias than there is room for is asked for, a full result tells that aliases were created since
+            // the count, the lookup then stays pending as if the count had been larger
+            err = get(handle, next.value.c_str(), static_cast<qdb_int_t>(room + 1), &results, &result_count);
+            if ((err != qdb_e_ok) && (err != qdb_e_alias_not_found)) return err;
+
+            if (err == qdb_e_alias_not_found)
+            {
+                pending.pop_back();
+                continue;
+            }
+
+            if (result_count <= room)
+            {
+                aliases.insert(aliases.end(), results, results + result_count);
+                qdb_release(handle, results);
+                pending.pop_back();
+                continue;
+            }
+
+            qdb_release(handle, results);
+            matches = static_cast<qdb_uint_t>(result_count);
+        }
+
+        // fits in the next page, which starts with it
+        if (matches <= page_size) break;
+
+        // too many matches for a page, split into the narrower lookups, run in ascending byte order
+        const std::string value = next.value;
+        pending.pop_back();
+
+        for (int c = 255; c > 0; --c)
+        {
+            const char b = static_cast<char>(c);
+            pending.push_back({lookup_all, suffix ? (b + value) : (value + b)});
+        }
+
+        pending.push_back({lookup_exact, value});
+    }
+
+    next_token = make_token(pending);
+    return qdb_e_ok;
+}
+
+} // namespace quasardb
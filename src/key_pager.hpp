@@ -0,0 +1,41 @@
+#pragma once
+
+#include <qdb/client.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace quasardb
+{
+
+// Enumerates the aliases matching a prefix, or a suffix, one page at a time.
+//
+// The C API returns every match of a lookup at once and has no continuation. Lookups matching more aliases than fit
+// in a page are thus split into narrower ones, the lookup extended by one byte, whose sizes are known from the count
+// functions. The lookups left to do make up the continuation token, so that an enumeration holds at most a page of
+// aliases and can be resumed from the token alone.
+//
+// Aliases created or removed during the enumeration may or may not be returned, as with the lookups themselves.
+struct key_pager
+{
+    using count_function = qdb_error_t (*)(qdb_handle_t, const char *, qdb_uint_t *);
+    using get_function = qdb_error_t (*)(qdb_handle_t, const char *, qdb_int_t, const char ***, size_t *);
+
+    count_function count;
+    get_function get;
+
+    // suffix lookups are narrowed by prepending a byte rather than appending it
+    bool suffix;
+
+    // Fills aliases with the next page, at most page_size aliases, and token with the continuation token, left empty
+    // once the enumeration is over. An empty input token starts the enumeration of root.
+    qdb_error_t page(qdb_handle_t handle,
+        const std::string & root,
+        const void * token,
+        size_t token_size,
+        size_t page_size,
+        std::vector<std::string> & aliases,
+        std::string & next_token) const;
+};
+
+} // namespace quasardb
@@ -0,0 +1,100 @@
+#include "keys.hpp"
+#include <array>
+#include <cassert>
+
+namespace quasardb
+{
+
+namespace
+{
+
+const char * const key_names[] = {
+    "timestamp",
+    "value",
+    "name",
+    "type",
+    "symtable",
+    "result",
+    "count",
+    "values",
+    "counts",
+    "timestamps",
+    "dictionary",
+    "codes",
+    "min",
+    "max",
+    "method",
+    "buckets",
+    "op",
+    "p",
+    "alpha",
+    "rows",
+    "row_count",
+    "column_names",
+    "column_count",
+    "scanned_point_count",
+    "error_message",
+    "reference",
+    "size",
+    "modification_time",
+    "expiry_time",
+    "hits",
+    "misses",
+    "evictions",
+    "entries",
+    "bytes",
+    "maxBytes",
+    "maxAge",
+    "exactExpiry",
+    "dedupe",
+    "batchSize",
+    "calls",
+    "errors",
+    "bytesIn",
+    "bytesOut",
+    "queue",
+    "execute",
+    "convert",
+    "mean",
+    "p50",
+    "p90",
+    "p99",
+    "operation",
+    "alias",
+    "phase",
+    "duration",
+    "error",
+    "hasSubscribers",
+    "publish",
+};
+
+static_assert(sizeof(key_names) / sizeof(key_names[0]) == static_cast<size_t>(key::key_count),
+    "key_names must match the key enumeration");
+
+// eternal handles are never collected, which is what we want for strings used for the whole process lifetime
+std::array<v8::Eternal<v8::String>, static_cast<size_t>(key::key_count)> keys;
+v8::Isolate * keys_isolate = nullptr;
+
+} // namespace
+
+void init_property_keys(v8::Isolate * isolate)
+{
+    if (keys_isolate) return;
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        keys[i].Set(isolate,
+            v8::String::NewFromUtf8(isolate, key_names[i], v8::NewStringType::kInternalized).ToLocalChecked());
+    }
+
+    keys_isolate = isolate;
+}
+
+v8::Local<v8::String> property_key(v8::Isolate * isolate, key k)
+{
+    assert((isolate == keys_isolate) && "Verify that init_property_keys has been called in qdb_api.cpp:InitAll()");
+
+    return keys[static_cast<size_t>(k)].Get(isolate);
+}
+
+} // namespace quasardb
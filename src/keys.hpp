@@ -0,0 +1,81 @@
+#pragma once
+
+#include <node.h>
+#include <cstddef>
+
+namespace quasardb
+{
+
+// Property names read from or set on JS objects by the converters and result builders, in the order of the names
+// table in keys.cpp.
+enum class key
+{
+    timestamp,
+    value,
+    name,
+    type,
+    symtable,
+    result,
+    count,
+    values,
+    counts,
+    timestamps,
+    dictionary,
+    codes,
+    minimum,
+    maximum,
+    method,
+    buckets,
+    op,
+    p,
+    alpha,
+    rows,
+    row_count,
+    column_names,
+    column_count,
+    scanned_point_count,
+    error_message,
+    reference,
+    size,
+    modification_time,
+    expiry_time,
+    hits,
+    misses,
+    evictions,
+    entries,
+    bytes,
+    max_bytes,
+    max_age,
+    exact_expiry,
+    dedupe,
+    batch_size,
+    calls,
+    errors,
+    bytes_in,
+    bytes_out,
+    queue,
+    execute,
+    convert,
+    mean,
+    p50,
+    p90,
+    p99,
+    operation,
+    alias,
+    phase,
+    duration,
+    error,
+    has_subscribers,
+    publish,
+
+    // not a key, number of keys
+    key_count
+};
+
+// Creates the internalized strings once, to be called from InitAll before any conversion happens.
+// The addon is not context aware and its constructors are process wide, the table belongs to the isolate loading it.
+void init_property_keys(v8::Isolate * isolate);
+
+v8::Local<v8::String> property_key(v8::Isolate * isolate, key k);
+
+} // namespace quasardb
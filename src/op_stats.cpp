@@ -0,0 +1,171 @@
+#include "op_stats.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace quasardb
+{
+
+namespace
+{
+
+// class whose methods are being registered, see op_stats::class_scope
+const char * registering_class = nullptr;
+
+size_t log2_floor(uint64_t v)
+{
+    size_t res = 0;
+    for (size_t shift = 32; shift > 0; shift /= 2)
+    {
+        if (v >> shift)
+        {
+            v >>= shift;
+            res += shift;
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+size_t latency_histogram::bucket_of(uint64_t micros)
+{
+    // the first magnitude holds the values below sub_buckets exactly
+    if (micros < sub_buckets) return static_cast<size_t>(micros);
+
+    const size_t highest_bit = log2_floor(micros);
+    const size_t magnitude = highest_bit - sub_bucket_bits + 1;
+    if (magnitude > magnitudes) return bucket_count - 1;
+
+    const size_t sub_bucket = static_cast<size_t>(micros >> (highest_bit - sub_bucket_bits)) - sub_buckets;
+    return magnitude * sub_buckets + sub_bucket;
+}
+
+uint64_t latency_histogram::highest_of(size_t bucket)
+{
+    const size_t magnitude = bucket / sub_buckets;
+    const uint64_t sub_bucket = bucket % sub_buckets;
+    if (magnitude == 0) return sub_bucket;
+
+    const uint64_t lowest = (sub_buckets + sub_bucket) << (magnitude - 1);
+    return lowest + (uint64_t(1) << (magnitude - 1)) - 1;
+}
+
+void latency_histogram::record(uint64_t micros)
+{
+    _buckets[bucket_of(micros)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t max = _max.load(std::memory_order_relaxed);
+    while ((micros > max) && !_max.compare_exchange_weak(max, micros, std::memory_order_relaxed))
+    {
+    }
+}
+
+latency_histogram::summary latency_histogram::summarize() const
+{
+    // read while requests may record, the figures are consistent enough for monitoring
+    std::array<uint64_t, bucket_count> buckets;
+    uint64_t count = 0;
+    for (size_t i = 0; i < bucket_count; ++i)
+    {
+        buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+        count += buckets[i];
+    }
+
+    summary res{};
+    res.count = count;
+    res.max = static_cast<double>(_max.load(std::memory_order_relaxed));
+    if (count == 0) return res;
+
+    res.mean = static_cast<double>(_sum.load(std::memory_order_relaxed)) / static_cast<double>(count);
+
+    const double quantiles[] = {0.5, 0.9, 0.99};
+    double * values[] = {&res.p50, &res.p90, &res.p99};
+
+    uint64_t seen = 0;
+    size_t q = 0;
+    for (size_t i = 0; (i < bucket_count) && (q < 3); ++i)
+    {
+        seen += buckets[i];
+        while ((q < 3) && (static_cast<double>(seen) >= quantiles[q] * static_cast<double>(count)) && (seen > 0))
+        {
+            *values[q++] = std::min(static_cast<double>(highest_of(i)), res.max);
+        }
+    }
+
+    return res;
+}
+
+op_stats::class_scope::class_scope(const char * class_name)
+    : _previous(registering_class)
+{
+    registering_class = class_name;
+}
+
+op_stats::class_scope::~class_scope()
+{
+    registering_class = _previous;
+}
+
+std::vector<std::string> & op_stats::operation_names()
+{
+    static std::vector<std::string> names;
+    return names;
+}
+
+uint32_t op_stats::register_operation(const char * method)
+{
+    assert(registering_class && "Operations are registered by Entry::InitConstructorOnly");
+
+    std::string name = registering_class ? registering_class : "";
+    name.append(".").append(method);
+
+    // derived classes register again the methods they override
+    auto & names = operation_names();
+    auto it = std::find(names.cbegin(), names.cend(), name);
+    if (it != names.cend()) return static_cast<uint32_t>(it - names.cbegin());
+
+    names.push_back(std::move(name));
+    return static_cast<uint32_t>(names.size() - 1);
+}
+
+const std::string & op_stats::operation_name(uint32_t operation)
+{
+    static const std::string unknown;
+
+    const auto & names = operation_names();
+    return (operation < names.size()) ? names[operation] : unknown;
+}
+
+op_stats::op_stats()
+    : _size(operation_names().size())
+    , _counters(new std::atomic<op_counters *>[_size]())
+{
+}
+
+op_stats::~op_stats()
+{
+    for (size_t i = 0; i < _size; ++i)
+    {
+        delete _counters[i].load(std::memory_order_relaxed);
+    }
+}
+
+op_counters & op_stats::counters(uint32_t operation)
+{
+    assert(operation < _size);
+
+    std::atomic<op_counters *> & slot = _counters[operation];
+
+    op_counters * c = slot.load(std::memory_order_acquire);
+    if (c) return *c;
+
+    // the first request of the operation allocates its counters, racing requests keep the first allocated
+    std::unique_ptr<op_counters> created(new op_counters());
+    if (slot.compare_exchange_strong(c, created.get(), std::memory_order_acq_rel)) return *created.release();
+
+    return *c;
+}
+
+} // namespace quasardb
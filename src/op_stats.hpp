@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace quasardb
+{
+
+// Latency histogram in microseconds, as HDR histograms do: every power of two is split in sub_buckets linear buckets,
+// so that percentiles are within 1/sub_buckets of the recorded values whatever their magnitude. Recording is lock free
+// and can happen from any thread.
+class latency_histogram
+{
+public:
+    static const size_t sub_bucket_bits = 3;
+    static const size_t sub_buckets = size_t(1) << sub_bucket_bits;
+
+    // values above 2^(magnitudes + sub_bucket_bits - 1) microseconds, more than a day, go to the last bucket
+    static const size_t magnitudes = 34;
+    static const size_t bucket_count = (magnitudes + 1) * sub_buckets;
+
+    struct summary
+    {
+        uint64_t count;
+        double mean;
+        double p50;
+        double p90;
+        double p99;
+        double max;
+    };
+
+public:
+    void record(uint64_t micros);
+
+    summary summarize() const;
+
+private:
+    static size_t bucket_of(uint64_t micros);
+
+    // highest value of the bucket
+    static uint64_t highest_of(size_t bucket);
+
+private:
+    std::array<std::atomic<uint64_t>, bucket_count> _buckets{};
+    std::atomic<uint64_t> _count{0};
+    std::atomic<uint64_t> _sum{0};
+    std::atomic<uint64_t> _max{0};
+};
+
+// Counters of one operation, such as Blob.get.
+struct op_counters
+{
+    // from the call to the start of the request on a worker thread
+    latency_histogram queue;
+    // the C API calls, on the worker thread
+    latency_histogram execute;
+    // conversion of the result to JS values, on the JS thread, the callback itself is not accounted
+    latency_histogram convert;
+
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> bytes_in{0};
+    std::atomic<uint64_t> bytes_out{0};
+};
+
+// Per operation statistics of the requests of a cluster.
+//
+// Operations are named after the class and the method, they are registered once when the classes are initialized,
+// before any statistics exist. Their counters are allocated on first use, most operations are never called.
+class op_stats
+{
+public:
+    // Names the operations registered while it lives after class_name, from the JS thread.
+    class class_scope
+    {
+    public:
+        explicit class_scope(const char * class_name);
+        ~class_scope();
+
+    private:
+        const char * _previous;
+    };
+
+    // Returns the identifier of the method of the class being initialized.
+    static uint32_t register_operation(const char * method);
+
+    // The name of a registered operation, such as Blob.get, empty for an unknown operation.
+    static const std::string & operation_name(uint32_t operation);
+
+public:
+    op_stats();
+    ~op_stats();
+
+    op_stats(const op_stats &) = delete;
+    op_stats & operator=(const op_stats &) = delete;
+
+public:
+    op_counters & counters(uint32_t operation);
+
+    // Calls f(name, counters) for every operation called at least once.
+    template <typename F>
+    void for_each(F f) const
+    {
+        for (size_t i = 0; i < _size; ++i)
+        {
+            const op_counters * c = _counters[i].load(std::memory_order_acquire);
+            if (c) f(operation_names()[i], *c);
+        }
+    }
+
+private:
+    static std::vector<std::string> & operation_names();
+
+private:
+    const size_t _size;
+    std::unique_ptr<std::atomic<op_counters *>[]> _counters;
+};
+
+using op_stats_ptr = std::shared_ptr<op_stats>;
+
+} // namespace quasardb
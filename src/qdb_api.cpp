@@ -1,4 +1,5 @@
 #include "cluster.hpp"
+#include "diagnostics.hpp"
 #include "ts_aggregation.hpp"
 #include "ts_column.hpp"
 #include "ts_point.hpp"
@@ -18,16 +19,24 @@ void InitConstants(v8::Local<v8::Object> exports)
     quasardb::detail::AddConstantProperty(isolate, exports, "COMPRESSION_NONE", v8::Int32::New(isolate, qdb_comp_none));
     quasardb::detail::AddConstantProperty(isolate, exports, "COMPRESSION_FAST", v8::Int32::New(isolate, qdb_comp_fast));
     quasardb::detail::AddConstantProperty(isolate, exports, "COMPRESSION_BEST", v8::Int32::New(isolate, qdb_comp_best));
+
+    quasardb::detail::AddConstantProperty(isolate, exports, "COMPRESSION_NONE",
+        v8::Int32::New(isolate, static_cast<int>(quasardb::blob_codec::none)));
+    quasardb::detail::AddConstantProperty(isolate, exports, "COMPRESSION_DEFLATE",
+        v8::Int32::New(isolate, static_cast<int>(quasardb::blob_codec::deflate)));
 }
 
 void InitAll(v8::Local<v8::Object> exports, v8::Local<v8::Object> module)
 {
     std::setlocale(LC_ALL, "en_US.UTF-8");
 
+    quasardb::init_property_keys(exports->GetIsolate());
+
     quasardb::Cluster::Init(exports);
 
     quasardb::Error::Init(exports);
 
+    quasardb::Batch::Init(exports);
     quasardb::Blob::Init(exports);
     quasardb::Integer::Init(exports);
     quasardb::Prefix::Init(exports);
@@ -46,12 +55,16 @@ void InitAll(v8::Local<v8::Object> exports, v8::Local<v8::Object> module)
     quasardb::DoubleColumn::Init(exports);
     quasardb::BlobColumn::Init(exports);
     quasardb::StringColumn::Init(exports);
+    quasardb::SymbolColumn::Init(exports);
     quasardb::Int64Column::Init(exports);
     quasardb::TimestampColumn::Init(exports);
+    quasardb::ColumnWriter::Init(exports);
     quasardb::Aggregation::Init(exports);
     quasardb::Timestamp::Init(exports);
 
     InitConstants(exports);
+
+    NODE_SET_METHOD(exports, "setDiagnosticsChannels", quasardb::SetDiagnosticsChannels);
 }
 
 NODE_MODULE(quasardb, InitAll)
@@ -39,7 +39,7 @@ public:
     static void Init(v8::Local<v8::Object> exports)
     {
         Entry<Query>::Init(
-            exports, "Query", [](v8::Local<v8::FunctionTemplate> tpl) { NODE_SET_PROTOTYPE_METHOD(tpl, "run", run); });
+            exports, "Query", [](v8::Local<v8::FunctionTemplate> tpl) { detail::SetOperation(tpl, "run", run); });
     }
 
 public:
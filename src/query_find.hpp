@@ -39,24 +39,66 @@ public:
     static void Init(v8::Local<v8::Object> exports)
     {
         Entry<QueryFind>::Init(exports, "QueryFind",
-            [](v8::Local<v8::FunctionTemplate> tpl) { NODE_SET_PROTOTYPE_METHOD(tpl, "run", run); });
+            [](v8::Local<v8::FunctionTemplate> tpl)
+            {
+                detail::SetOperation(tpl, "run", run);
+                detail::SetOperation(tpl, "runPacked", runPacked);
+                detail::SetOperation(tpl, "count", count);
+            });
     }
 
 public:
     static void run(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Entry<QueryFind>::queue_work(args, executeRun, Entry<QueryFind>::processArrayStringResult);
+    }
+
+    // :desc: Same as run, with the aliases concatenated in a single Buffer rather than in an array of strings.
+    // :args: callback(err, data, offsets) (function) - A callback function with err, data and offsets parameters, the
+    // alias i being the bytes of data from offsets[i] to offsets[i + 1].
+    static void runPacked(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Entry<QueryFind>::queue_work(
+            args,
+            [](qdb_request * qdb_req)
+            {
+                executeRun(qdb_req);
+                qdb_req->pack_aliases();
+            },
+            Entry<QueryFind>::processPackedStringResult);
+    }
+
+    // :desc: Counts the aliases matching the query. There is no count primitive for find queries, the matches are
+    // retrieved and counted on the worker thread, but not converted.
+    // :args: callback(err, count) (function) - A callback function with err and count parameters.
+    static void count(const v8::FunctionCallbackInfo<v8::Value> & args)
     {
         Entry<QueryFind>::queue_work(
             args,
             [](qdb_request * qdb_req)
             {
-                qdb_req->output.error = qdb_query_find(qdb_req->handle(), qdb_req->input.alias.c_str(),
-                    reinterpret_cast<const char ***>(const_cast<void **>(&(qdb_req->output.content.buffer.begin))),
-                    &(qdb_req->output.content.buffer.size));
+                executeRun(qdb_req);
+
+                const void * entries = qdb_req->output.content.buffer.begin;
+                const size_t count = (qdb_req->output.error == qdb_e_ok) ? qdb_req->output.content.buffer.size : 0;
+
+                // safe to call even on null/invalid buffers
+                if (qdb_req->output.error == qdb_e_ok) qdb_release(qdb_req->handle(), entries);
+
+                qdb_req->output.content.uvalue = count;
+                if (qdb_req->output.error == qdb_e_alias_not_found) qdb_req->output.error = qdb_e_ok;
             },
-            Entry<QueryFind>::processArrayStringResult);
+            Entry<QueryFind>::processUintegerResult);
     }
 
 private:
+    static void executeRun(qdb_request * qdb_req)
+    {
+        qdb_req->output.error = qdb_query_find(qdb_req->handle(), qdb_req->input.alias.c_str(),
+            reinterpret_cast<const char ***>(const_cast<void **>(&(qdb_req->output.content.buffer.begin))),
+            &(qdb_req->output.content.buffer.size));
+    }
+
     static void New(const v8::FunctionCallbackInfo<v8::Value> & args);
 
 private:
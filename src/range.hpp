@@ -42,8 +42,8 @@ public:
         Entry<Range>::InitConstructorOnly(exports, "Range",
             [](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "blobScan", blobScan);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "blobScanRegex", blobScanRegex);
+                detail::SetOperation(tpl, "blobScan", blobScan);
+                detail::SetOperation(tpl, "blobScanRegex", blobScanRegex);
             });
     }
 
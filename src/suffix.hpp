@@ -1,6 +1,7 @@
 #pragma once
 
 #include "entry.hpp"
+#include "key_pager.hpp"
 
 #include <qdb/client.h>
 #include <qdb/suffix.h>
@@ -10,6 +11,7 @@
 #include <node_object_wrap.h>
 #include <uv.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -42,8 +44,11 @@ public:
         Entry<Suffix>::InitConstructorOnly(exports, "Suffix",
             [](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "getEntries", getEntries);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "suffix", Entry<Suffix>::alias);
+                detail::SetOperation(tpl, "getEntries", getEntries);
+                detail::SetOperation(tpl, "getEntriesPacked", getEntriesPacked);
+                detail::SetOperation(tpl, "count", count);
+                detail::SetOperation(tpl, "getPage", getPage);
+                detail::SetOperation(tpl, "suffix", Entry<Suffix>::alias);
             });
     }
 
@@ -53,20 +58,75 @@ public:
     // callback(err, aliases) (function) - A callback function with err and aliases parameter, aliases would hold the
     // answer.
     static void getEntries(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Entry<Suffix>::queue_work(
+            args, executeGetEntries, Entry<Suffix>::processArrayStringResult, &ArgsEaterBinder::integer);
+    }
+
+    // :desc: Same as getEntries, with the aliases concatenated in a single Buffer rather than in an array of strings.
+    // :args: maxCount (int) - maximum count of returned aliases.
+    // callback(err, data, offsets) (function) - A callback function with err, data and offsets parameters, the alias i
+    // being the bytes of data from offsets[i] to offsets[i + 1].
+    static void getEntriesPacked(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Entry<Suffix>::queue_work(
+            args,
+            [](qdb_request * qdb_req)
+            {
+                executeGetEntries(qdb_req);
+                qdb_req->pack_aliases();
+            },
+            Entry<Suffix>::processPackedStringResult, &ArgsEaterBinder::integer);
+    }
+
+    // :desc: Counts the aliases matching the specified suffix string, without retrieving them.
+    // :args: callback(err, count) (function) - A callback function with err and count parameters.
+    static void count(const v8::FunctionCallbackInfo<v8::Value> & args)
     {
         Entry<Suffix>::queue_work(
             args,
             [](qdb_request * qdb_req)
             {
-                qdb_req->output.error = qdb_suffix_get(qdb_req->handle(), qdb_req->input.alias.c_str(),
-                    /*max_count=*/qdb_req->input.content.value,
-                    reinterpret_cast<const char ***>(const_cast<void **>(&(qdb_req->output.content.buffer.begin))),
-                    &(qdb_req->output.content.buffer.size));
+                qdb_req->output.content.uvalue = 0;
+                qdb_req->output.error = qdb_suffix_count(
+                    qdb_req->handle(), qdb_req->input.alias.c_str(), &(qdb_req->output.content.uvalue));
+
+                // no match is a count of zero
+                if (qdb_req->output.error == qdb_e_alias_not_found) qdb_req->output.error = qdb_e_ok;
             },
-            Entry<Suffix>::processArrayStringResult, &ArgsEaterBinder::integer);
+            Entry<Suffix>::processUintegerResult);
+    }
+
+    // :desc: Gets a page of the matched aliases of the specified suffix string, see iterate() for the usual interface.
+    // :args: pageSize (int) - maximum count of returned aliases.
+    // token (Buffer) - the continuation token of the previous page, an empty Buffer for the first page.
+    // callback(err, aliases, token) (function) - A callback function with err, aliases and token parameters, token
+    // being null once every alias has been returned.
+    static void getPage(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Entry<Suffix>::queue_work(
+            args,
+            [](qdb_request * qdb_req)
+            {
+                static const key_pager pager = {qdb_suffix_count, qdb_suffix_get, /*suffix=*/true};
+
+                const auto & token = qdb_req->input.content.buffer;
+                const qdb_int_t page_size = std::max<qdb_int_t>(qdb_req->input.content.value, 0);
+                qdb_req->output.error = pager.page(qdb_req->handle(), qdb_req->input.alias, token.begin, token.size,
+                    static_cast<size_t>(page_size), qdb_req->output.page.aliases, qdb_req->output.page.token);
+            },
+            Entry<Suffix>::processKeyPageResult, &ArgsEaterBinder::integer, &ArgsEaterBinder::buffer);
     }
 
 private:
+    static void executeGetEntries(qdb_request * qdb_req)
+    {
+        qdb_req->output.error = qdb_suffix_get(qdb_req->handle(), qdb_req->input.alias.c_str(),
+            /*max_count=*/qdb_req->input.content.value,
+            reinterpret_cast<const char ***>(const_cast<void **>(&(qdb_req->output.content.buffer.begin))),
+            &(qdb_req->output.content.buffer.size));
+    }
+
     static void New(const v8::FunctionCallbackInfo<v8::Value> & args);
 
 private:
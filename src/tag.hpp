@@ -39,7 +39,12 @@ public:
     static void Init(v8::Local<v8::Object> exports)
     {
         Entry<Tag>::Init(exports, "Tag",
-            [](v8::Local<v8::FunctionTemplate> tpl) { NODE_SET_PROTOTYPE_METHOD(tpl, "getEntries", getEntries); });
+            [](v8::Local<v8::FunctionTemplate> tpl)
+            {
+                detail::SetOperation(tpl, "getEntries", getEntries);
+                detail::SetOperation(tpl, "getEntriesPacked", getEntriesPacked);
+                detail::SetOperation(tpl, "count", count);
+            });
     }
 
 public:
@@ -47,19 +52,51 @@ public:
     // :args: callback(err, entities) (function) - A callback or anonymous function with error and array of entities
     // parameters.
     static void getEntries(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Entry<Tag>::queue_work(args, executeGetEntries, Entry<Tag>::processArrayStringResult);
+    }
+
+    // :desc: Same as getEntries, with the aliases concatenated in a single Buffer rather than in an array of strings.
+    // :args: callback(err, data, offsets) (function) - A callback or anonymous function with error, data and offsets
+    // parameters, the alias i being the bytes of data from offsets[i] to offsets[i + 1].
+    static void getEntriesPacked(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        Entry<Tag>::queue_work(
+            args,
+            [](qdb_request * qdb_req)
+            {
+                executeGetEntries(qdb_req);
+                qdb_req->pack_aliases();
+            },
+            Entry<Tag>::processPackedStringResult);
+    }
+
+    // :desc: Counts the entities associated with the Tag, without retrieving them.
+    // :args: callback(err, count) (function) - A callback or anonymous function with error and count parameters.
+    static void count(const v8::FunctionCallbackInfo<v8::Value> & args)
     {
         Entry<Tag>::queue_work(
             args,
             [](qdb_request * qdb_req)
             {
-                qdb_req->output.error = qdb_get_tagged(qdb_req->handle(), qdb_req->input.alias.c_str(),
-                    reinterpret_cast<const char ***>(const_cast<void **>(&(qdb_req->output.content.buffer.begin))),
-                    &(qdb_req->output.content.buffer.size));
+                qdb_req->output.content.uvalue = 0;
+                qdb_req->output.error = qdb_get_tagged_count(
+                    qdb_req->handle(), qdb_req->input.alias.c_str(), &(qdb_req->output.content.uvalue));
+
+                // a tag without entities does not exist
+                if (qdb_req->output.error == qdb_e_alias_not_found) qdb_req->output.error = qdb_e_ok;
             },
-            Entry<Tag>::processArrayStringResult);
+            Entry<Tag>::processUintegerResult);
     }
 
 private:
+    static void executeGetEntries(qdb_request * qdb_req)
+    {
+        qdb_req->output.error = qdb_get_tagged(qdb_req->handle(), qdb_req->input.alias.c_str(),
+            reinterpret_cast<const char ***>(const_cast<void **>(&(qdb_req->output.content.buffer.begin))),
+            &(qdb_req->output.content.buffer.size));
+    }
+
     static void New(const v8::FunctionCallbackInfo<v8::Value> & args);
 
 private:
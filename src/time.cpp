@@ -1,8 +1,49 @@
 #include "time.hpp"
+#include <cmath>
 
 namespace quasardb
 {
 v8::Persistent<v8::Function> Timestamp::constructor;
 v8::Persistent<v8::FunctionTemplate> Timestamp::tmpl;
 
+static bool ms_value_to_qdb_timespec(double ms, qdb_timespec_t & ts)
+{
+    // beyond that the nanoseconds do not fit in 64-bit
+    if (!(std::abs(ms) < 9.2e12)) return false;
+
+    // split to keep the sub-millisecond part exact
+    const double whole = std::floor(ms);
+    ts = ns_to_qdb_timespec(
+        static_cast<int64_t>(whole) * 1000000ll + static_cast<int64_t>(std::llround((ms - whole) * 1e6)));
+    return true;
+}
+
+bool value_to_qdb_timespec(v8::Isolate * isolate, v8::Local<v8::Value> value, qdb_timespec_t & ts)
+{
+    if (value->IsBigInt())
+    {
+        bool lossless = false;
+        const int64_t ns = value.As<v8::BigInt>()->Int64Value(&lossless);
+        if (!lossless) return false;
+
+        ts = ns_to_qdb_timespec(ns);
+        return true;
+    }
+
+    if (value->IsNumber())
+    {
+        return ms_value_to_qdb_timespec(value.As<v8::Number>()->Value(), ts);
+    }
+
+    if (value->IsDate())
+    {
+        return ms_value_to_qdb_timespec(value.As<v8::Date>()->ValueOf(), ts);
+    }
+
+    if (!value->IsObject() || !Timestamp::InstanceOf(isolate, value)) return false;
+
+    ts = node::ObjectWrap::Unwrap<Timestamp>(value.As<v8::Object>())->getTimespec();
+    return true;
+}
+
 } // namespace quasardb
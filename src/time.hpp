@@ -6,6 +6,7 @@
 #include <node.h>
 #include <node_object_wrap.h>
 #include <chrono>
+#include <cstdint>
 
 namespace quasardb
 {
@@ -30,6 +31,26 @@ inline double qdb_timespec_to_ms(const qdb_timespec_t & ts)
     return static_cast<double>(ts.tv_sec) * 1000.0 + static_cast<double>(ts.tv_nsec / 1000000ull);
 }
 
+inline int64_t qdb_timespec_to_ns(const qdb_timespec_t & ts)
+{
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + static_cast<int64_t>(ts.tv_nsec);
+}
+
+inline qdb_timespec_t ns_to_qdb_timespec(int64_t ns)
+{
+    // tv_nsec is always in [0, 1e9), including before epoch
+    qdb_timespec_t ts;
+    ts.tv_sec = static_cast<qdb_time_t>(ns / 1000000000ll);
+    ts.tv_nsec = static_cast<qdb_time_t>(ns % 1000000000ll);
+    if (ts.tv_nsec < 0)
+    {
+        ts.tv_sec -= 1;
+        ts.tv_nsec += 1000000000ll;
+    }
+
+    return ts;
+}
+
 class Timestamp : public node::ObjectWrap
 {
 public:
@@ -216,4 +237,8 @@ private:
     nanoseconds nanoseconds_;
 };
 
+// Converts a time since epoch given either as a Timestamp, a BigInt of nanoseconds, a Number of milliseconds or a
+// Date, without allocating any intermediate object. Returns false for any other value.
+bool value_to_qdb_timespec(v8::Isolate * isolate, v8::Local<v8::Value> value, qdb_timespec_t & ts);
+
 } // namespace quasardb
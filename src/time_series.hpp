@@ -36,9 +36,9 @@ public:
         Entry<TimeSeries>::Init(exports, "TimeSeries",
             [exports](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "create", ts_create);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "insert", ts_insert_columns);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "columns", columns);
+                detail::SetOperation(tpl, "create", ts_create);
+                detail::SetOperation(tpl, "insert", ts_insert_columns);
+                detail::SetOperation(tpl, "columns", columns);
 
                 // Export to global namespace
                 NODE_SET_METHOD(exports, "DoubleColumnInfo", columnInfoTpl<qdb_ts_column_double>);
@@ -99,15 +99,11 @@ private:
             return;
         }
 
-        info->Set(isolate->GetCurrentContext(),
-            v8::String::NewFromUtf8(isolate, "name", v8::NewStringType::kNormal).ToLocalChecked(), args[0]);
-        info->Set(isolate->GetCurrentContext(),
-            v8::String::NewFromUtf8(isolate, "type", v8::NewStringType::kNormal).ToLocalChecked(),
-            v8::Integer::New(isolate, type));
+        info->Set(isolate->GetCurrentContext(), property_key(isolate, key::name), args[0]);
+        info->Set(isolate->GetCurrentContext(), property_key(isolate, key::type), v8::Integer::New(isolate, type));
         if (is_symbol)
         {
-            info->Set(isolate->GetCurrentContext(),
-                v8::String::NewFromUtf8(isolate, "symtable", v8::NewStringType::kNormal).ToLocalChecked(), args[1]);
+            info->Set(isolate->GetCurrentContext(), property_key(isolate, key::symtable), args[1]);
         }
         args.GetReturnValue().Set(info);
     }
@@ -2,14 +2,49 @@
 #include "entry.hpp"
 #include "error.hpp"
 #include "time_series.hpp"
+#include "ts_downsample.hpp"
+#include "ts_kernels.hpp"
 #include "ts_point.hpp"
 #include <qdb/ts.h>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
 
 namespace quasardb
 {
 
+namespace detail
+{
+
+// Builds points out of typed arrays captured on the JS thread, meant to be run on the worker thread.
+// Fails when the arrays are missing, empty or of different lengths.
+template <typename Value, typename Point, typename Assign>
+static bool columnar_to_points(const columnar_points & columnar, std::vector<Point> & points, Assign assign)
+{
+    const size_t count = columnar.timestamps.length;
+    if (!columnar.timestamps.store || !columnar.values.store || !count || (columnar.values.length != count))
+    {
+        return false;
+    }
+
+    const int64_t * timestamps = columnar.timestamps.data<int64_t>();
+    const Value * values = columnar.values.data<Value>();
+
+    points.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        points[i].timestamp = ns_to_qdb_timespec(timestamps[i]);
+        assign(points[i], values[i]);
+    }
+
+    return true;
+}
+
+} // namespace detail
+
 v8::Persistent<v8::Function> BlobColumn::constructor;
 v8::Persistent<v8::Function> StringColumn::constructor;
+v8::Persistent<v8::Function> SymbolColumn::constructor;
 v8::Persistent<v8::Function> DoubleColumn::constructor;
 v8::Persistent<v8::Function> Int64Column::constructor;
 v8::Persistent<v8::Function> TimestampColumn::constructor;
@@ -35,7 +70,7 @@ void BlobColumn::insert(const v8::FunctionCallbackInfo<v8::Value> & args)
                 qdb_req->output.error = qdb_ts_blob_insert(qdb_req->handle(), ts, alias, points.data(), points.size());
             }
         },
-        Entry<Column>::processVoidResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::blobPoints);
+        Entry<Column>::processVoidResult, &ArgsEaterBinder::blobPoints);
 }
 
 void BlobColumn::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
@@ -54,7 +89,7 @@ void BlobColumn::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
             qdb_req->output.error =
                 qdb_ts_blob_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), bufp, count);
         },
-        BlobColumn::processBlobPointArrayResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::ranges);
+        BlobColumn::processBlobPointArrayResult, &ArgsEaterBinder::ranges);
 }
 
 void BlobColumn::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
@@ -70,67 +105,174 @@ void BlobColumn::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
 
             qdb_req->output.error = qdb_ts_blob_aggregate(qdb_req->handle(), ts, alias, aggrs, count);
         },
-        BlobColumn::processBlobAggregateResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::blobAggregations);
+        BlobColumn::processBlobAggregateResult, &ArgsEaterBinder::blobAggregations);
 }
 
-void StringColumn::insert(const v8::FunctionCallbackInfo<v8::Value> & args)
+void StringColumn::executeInsert(qdb_request * qdb_req)
 {
-    Column<StringColumn>::queue_work(
-        args,
-        [](qdb_request * qdb_req)
+    const auto alias = qdb_req->input.alias.c_str();
+    const auto ts = qdb_req->input.content.str.c_str();
+    const auto & points = qdb_req->input.content.string_points;
+
+    // FIXME(Marek): It's a poor man's hack, because ArgsEaterBinder::stringPoints returns an empty collection
+    // when an incorrect input has been given. But C API accepts 0-sized inputs.
+    if (points.empty())
+    {
+        qdb_req->output.error = qdb_e_invalid_argument;
+    }
+    else
+    {
+        qdb_req->output.error = qdb_ts_string_insert(qdb_req->handle(), ts, alias, points.data(), points.size());
+    }
+}
+
+void StringColumn::executeRanges(qdb_request * qdb_req)
+{
+    const auto alias = qdb_req->input.alias.c_str();
+    const auto ts = qdb_req->input.content.str.c_str();
+    auto & ranges = qdb_req->input.content.ranges;
+    auto bufp = reinterpret_cast<qdb_ts_string_point **>(const_cast<void **>(&(qdb_req->output.content.buffer.begin)));
+    auto count = &(qdb_req->output.content.buffer.size);
+
+    qdb_req->output.error =
+        qdb_ts_string_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), bufp, count);
+}
+
+void StringColumn::executeAggregate(qdb_request * qdb_req)
+{
+    const auto alias = qdb_req->input.alias.c_str();
+    const auto ts = qdb_req->input.content.str.c_str();
+    qdb_ts_string_aggregation_t * aggrs = qdb_req->input.content.string_aggrs.data();
+    const qdb_size_t count = qdb_req->input.content.string_aggrs.size();
+
+    qdb_req->output.error = qdb_ts_string_aggregate(qdb_req->handle(), ts, alias, aggrs, count);
+}
+
+void StringColumn::executeRangesColumnar(qdb_request * qdb_req)
+{
+    const auto alias = qdb_req->input.alias.c_str();
+    const auto ts = qdb_req->input.content.str.c_str();
+    const auto & ranges = qdb_req->input.content.ranges;
+
+    qdb_ts_string_point * points = nullptr;
+    qdb_size_t count = 0;
+
+    qdb_req->output.error =
+        qdb_ts_string_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), &points, &count);
+    if (qdb_req->output.error == qdb_e_ok)
+    {
+        auto & columnar = qdb_req->output.columnar;
+        columnar.timestamps.resize(count);
+        columnar.codes.resize(count);
+
+        // meant for symbol columns, which have a low cardinality, each distinct value is converted to a JS
+        // string only once
+        std::unordered_map<std::string, uint32_t> codes;
+        for (size_t i = 0; i < count; ++i)
         {
-            const auto alias = qdb_req->input.alias.c_str();
-            const auto ts = qdb_req->input.content.str.c_str();
-            const auto & points = qdb_req->input.content.string_points;
+            columnar.timestamps[i] = qdb_timespec_to_ns(points[i].timestamp);
 
-            // FIXME(Marek): It's a poor man's hack, because ArgsEaterBinder::stringPoints returns an empty collection
-            // when an incorrect input has been given. But C API accepts 0-sized inputs.
-            if (points.empty())
+            std::string value(points[i].content, points[i].content_length);
+            auto it = codes.find(value);
+            if (it == codes.end())
             {
-                qdb_req->output.error = qdb_e_invalid_argument;
+                it = codes.emplace(value, static_cast<uint32_t>(columnar.dictionary.size())).first;
+                columnar.dictionary.push_back(std::move(value));
             }
-            else
-            {
-                qdb_req->output.error =
-                    qdb_ts_string_insert(qdb_req->handle(), ts, alias, points.data(), points.size());
-            }
-        },
-        Entry<Column>::processVoidResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::stringPoints);
+            columnar.codes[i] = it->second;
+        }
+    }
+
+    qdb_release(qdb_req->handle(), points);
 }
 
-void StringColumn::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
+void StringColumn::insert(const v8::FunctionCallbackInfo<v8::Value> & args)
 {
     StringColumn::queue_work(
-        args,
-        [](qdb_request * qdb_req)
-        {
-            const auto alias = qdb_req->input.alias.c_str();
-            const auto ts = qdb_req->input.content.str.c_str();
-            auto & ranges = qdb_req->input.content.ranges;
-            auto bufp =
-                reinterpret_cast<qdb_ts_string_point **>(const_cast<void **>(&(qdb_req->output.content.buffer.begin)));
-            auto count = &(qdb_req->output.content.buffer.size);
+        args, StringColumn::executeInsert, Entry<StringColumn>::processVoidResult, &ArgsEaterBinder::stringPoints);
+}
 
-            qdb_req->output.error =
-                qdb_ts_string_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), bufp, count);
-        },
-        StringColumn::processStringPointArrayResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::ranges);
+void StringColumn::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    StringColumn::queue_work(
+        args, StringColumn::executeRanges, StringColumn::processStringPointArrayResult, &ArgsEaterBinder::ranges);
 }
 
 void StringColumn::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
 {
-    StringColumn::queue_work(
-        args,
-        [](qdb_request * qdb_req)
+    StringColumn::queue_work(args, StringColumn::executeAggregate, StringColumn::processStringAggregateResult,
+        &ArgsEaterBinder::stringAggregations);
+}
+
+void StringColumn::rangesColumnar(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    StringColumn::queue_work(args, StringColumn::executeRangesColumnar, StringColumn::processStringColumnarResult,
+        &ArgsEaterBinder::ranges);
+}
+
+// symbol columns are read and written with the string calls of the C API, which resolve the symbol table
+void SymbolColumn::insert(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    SymbolColumn::queue_work(
+        args, StringColumn::executeInsert, Entry<SymbolColumn>::processVoidResult, &ArgsEaterBinder::stringPoints);
+}
+
+void SymbolColumn::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    SymbolColumn::queue_work(
+        args, StringColumn::executeRanges, StringColumn::processStringPointArrayResult, &ArgsEaterBinder::ranges);
+}
+
+void SymbolColumn::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    SymbolColumn::queue_work(args, StringColumn::executeAggregate, StringColumn::processStringAggregateResult,
+        &ArgsEaterBinder::stringAggregations);
+}
+
+void SymbolColumn::rangesColumnar(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    SymbolColumn::queue_work(args, StringColumn::executeRangesColumnar, StringColumn::processStringColumnarResult,
+        &ArgsEaterBinder::ranges);
+}
+
+void StringColumn::processStringColumnarResult(uv_work_t * req, int status)
+{
+    processResult<2>(req, status,
+        [&](v8::Isolate * isolate, qdb_request * qdb_req)
         {
-            const auto alias = qdb_req->input.alias.c_str();
-            const auto ts = qdb_req->input.content.str.c_str();
-            qdb_ts_string_aggregation_t * aggrs = qdb_req->input.content.string_aggrs.data();
-            const qdb_size_t count = qdb_req->input.content.string_aggrs.size();
+            auto error_code = processErrorCode(isolate, status, qdb_req);
+            auto context = isolate->GetCurrentContext();
+
+            // provide empty arrays on error
+            const auto & columnar = qdb_req->output.columnar;
+            const bool ok = (qdb_req->output.error == qdb_e_ok) && (status >= 0);
+            const size_t count = ok ? columnar.codes.size() : 0u;
+            const size_t dictionary_size = ok ? columnar.dictionary.size() : 0u;
+
+            int64_t * timestamps;
+            uint32_t * codes;
+            auto timestamps_array = detail::NewTypedArray<v8::BigInt64Array>(isolate, count, timestamps);
+            auto codes_array = detail::NewTypedArray<v8::Uint32Array>(isolate, count, codes);
+            std::copy(columnar.timestamps.begin(), columnar.timestamps.begin() + count, timestamps);
+            std::copy(columnar.codes.begin(), columnar.codes.begin() + count, codes);
+
+            auto dictionary = v8::Array::New(isolate, static_cast<int>(dictionary_size));
+            for (size_t i = 0; i < dictionary_size; ++i)
+            {
+                const auto & value = columnar.dictionary[i];
+                dictionary->Set(context, static_cast<uint32_t>(i),
+                    v8::String::NewFromUtf8(
+                        isolate, value.data(), v8::NewStringType::kNormal, static_cast<int>(value.size()))
+                        .ToLocalChecked());
+            }
 
-            qdb_req->output.error = qdb_ts_string_aggregate(qdb_req->handle(), ts, alias, aggrs, count);
-        },
-        StringColumn::processStringAggregateResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::stringAggregations);
+            auto obj = v8::Object::New(isolate);
+            obj->Set(context, property_key(isolate, key::timestamps), timestamps_array);
+            obj->Set(context, property_key(isolate, key::dictionary), dictionary);
+            obj->Set(context, property_key(isolate, key::codes), codes_array);
+
+            return make_value_array(error_code, obj);
+        });
 }
 
 void DoubleColumn::insert(const v8::FunctionCallbackInfo<v8::Value> & args)
@@ -156,7 +298,30 @@ void DoubleColumn::insert(const v8::FunctionCallbackInfo<v8::Value> & args)
                     qdb_ts_double_insert(qdb_req->handle(), ts, alias, points.data(), points.size());
             }
         },
-        Entry<Column>::processVoidResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::doublePoints);
+        Entry<Column>::processVoidResult, &ArgsEaterBinder::doublePoints);
+}
+
+void DoubleColumn::insertColumnar(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Column<DoubleColumn>::queue_work(
+        args,
+        [](qdb_request * qdb_req)
+        {
+            const auto alias = qdb_req->input.alias.c_str();
+            const auto ts = qdb_req->input.content.str.c_str();
+            auto & points = qdb_req->input.content.double_points;
+
+            // the conversion happens here, the JS thread only captured the typed arrays
+            if (!detail::columnar_to_points<double>(qdb_req->input.content.columnar, points,
+                    [](qdb_ts_double_point & p, double v) { p.value = v; }))
+            {
+                qdb_req->output.error = qdb_e_invalid_argument;
+                return;
+            }
+
+            qdb_req->output.error = qdb_ts_double_insert(qdb_req->handle(), ts, alias, points.data(), points.size());
+        },
+        Entry<Column>::processVoidResult, &ArgsEaterBinder::doubleColumnarPoints);
 }
 
 void DoubleColumn::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
@@ -175,10 +340,10 @@ void DoubleColumn::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
             qdb_req->output.error =
                 qdb_ts_double_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), bufp, count);
         },
-        DoubleColumn::processDoublePointArrayResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::ranges);
+        DoubleColumn::processDoublePointArrayResult, &ArgsEaterBinder::ranges);
 }
 
-void DoubleColumn::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
+void DoubleColumn::rangesDownsampled(const v8::FunctionCallbackInfo<v8::Value> & args)
 {
     DoubleColumn::queue_work(
         args,
@@ -186,12 +351,51 @@ void DoubleColumn::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
         {
             const auto alias = qdb_req->input.alias.c_str();
             const auto ts = qdb_req->input.content.str.c_str();
-            qdb_ts_double_aggregation_t * aggrs = qdb_req->input.content.double_aggrs.data();
-            const qdb_size_t count = qdb_req->input.content.double_aggrs.size();
+            const auto & ranges = qdb_req->input.content.ranges;
+            const auto & options = qdb_req->input.content.downsample;
+
+            if (!options.valid())
+            {
+                qdb_req->output.error = qdb_e_invalid_argument;
+                return;
+            }
+
+            qdb_ts_double_point * points = nullptr;
+            qdb_size_t count = 0;
 
-            qdb_req->output.error = qdb_ts_double_aggregate(qdb_req->handle(), ts, alias, aggrs, count);
+            qdb_req->output.error =
+                qdb_ts_double_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), &points, &count);
+            if (qdb_req->output.error == qdb_e_ok)
+            {
+                downsample(points, count, options, qdb_req->output.double_points);
+            }
+
+            // the full series is not needed anymore, only the reduced one crosses to the JS thread
+            qdb_release(qdb_req->handle(), points);
         },
-        DoubleColumn::processDoubleAggregateResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::doubleAggregations);
+        DoubleColumn::processDownsampledResult, &ArgsEaterBinder::ranges, &ArgsEaterBinder::downsampleOptions);
+}
+
+void DoubleColumn::executeAggregate(qdb_request * qdb_req)
+{
+    const auto alias = qdb_req->input.alias.c_str();
+    const auto ts = qdb_req->input.content.str.c_str();
+    qdb_ts_double_aggregation_t * aggrs = qdb_req->input.content.double_aggrs.data();
+    const qdb_size_t count = qdb_req->input.content.double_aggrs.size();
+
+    qdb_req->output.error = qdb_ts_double_aggregate(qdb_req->handle(), ts, alias, aggrs, count);
+}
+
+void DoubleColumn::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    DoubleColumn::queue_work(args, DoubleColumn::executeAggregate, DoubleColumn::processDoubleAggregateResult,
+        &ArgsEaterBinder::doubleAggregations);
+}
+
+void DoubleColumn::aggregateColumnar(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    DoubleColumn::queue_work(args, DoubleColumn::executeAggregate, DoubleColumn::processDoubleColumnarAggregateResult,
+        &ArgsEaterBinder::doubleAggregations);
 }
 
 void BlobColumn::processBlobPointArrayResult(uv_work_t * req, int status)
@@ -256,10 +460,8 @@ void BlobColumn::processBlobAggregateResult(uv_work_t * req, int status)
                 }
                 else
                 {
-                    auto resprop =
-                        v8::String::NewFromUtf8(isolate, "result", v8::NewStringType::kNormal).ToLocalChecked();
-                    auto cntprop =
-                        v8::String::NewFromUtf8(isolate, "count", v8::NewStringType::kNormal).ToLocalChecked();
+                    auto resprop = property_key(isolate, key::result);
+                    auto cntprop = property_key(isolate, key::count);
 
                     for (size_t i = 0; i < aggrs.size(); ++i)
                     {
@@ -350,10 +552,8 @@ void StringColumn::processStringAggregateResult(uv_work_t * req, int status)
                 }
                 else
                 {
-                    auto resprop =
-                        v8::String::NewFromUtf8(isolate, "result", v8::NewStringType::kNormal).ToLocalChecked();
-                    auto cntprop =
-                        v8::String::NewFromUtf8(isolate, "count", v8::NewStringType::kNormal).ToLocalChecked();
+                    auto resprop = property_key(isolate, key::result);
+                    auto cntprop = property_key(isolate, key::count);
 
                     for (size_t i = 0; i < aggrs.size(); ++i)
                     {
@@ -382,6 +582,38 @@ void StringColumn::processStringAggregateResult(uv_work_t * req, int status)
         });
 }
 
+void DoubleColumn::compute(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    DoubleColumn::queue_work(
+        args,
+        [](qdb_request * qdb_req)
+        {
+            const auto alias = qdb_req->input.alias.c_str();
+            const auto ts = qdb_req->input.content.str.c_str();
+            const auto & ranges = qdb_req->input.content.ranges;
+            const auto & kernels = qdb_req->input.content.kernels;
+
+            if (kernels.empty())
+            {
+                qdb_req->output.error = qdb_e_invalid_argument;
+                return;
+            }
+
+            qdb_ts_double_point * points = nullptr;
+            qdb_size_t count = 0;
+
+            qdb_req->output.error =
+                qdb_ts_double_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), &points, &count);
+            if (qdb_req->output.error == qdb_e_ok)
+            {
+                run_kernels(points, count, kernels, qdb_req->output.kernels);
+            }
+
+            qdb_release(qdb_req->handle(), points);
+        },
+        Column<DoubleColumn>::processKernelResult, &ArgsEaterBinder::ranges, &ArgsEaterBinder::kernels);
+}
+
 void DoubleColumn::processDoublePointArrayResult(uv_work_t * req, int status)
 {
     processResult<2>(req, status,
@@ -423,6 +655,60 @@ void DoubleColumn::processDoublePointArrayResult(uv_work_t * req, int status)
         });
 }
 
+void DoubleColumn::processDownsampledResult(uv_work_t * req, int status)
+{
+    processResult<2>(req, status,
+        [&](v8::Isolate * isolate, qdb_request * qdb_req)
+        {
+            v8::Local<v8::Array> array;
+
+            auto error_code = processErrorCode(isolate, status, qdb_req);
+            if ((qdb_req->output.error == qdb_e_ok) && (status >= 0))
+            {
+                const auto & points = qdb_req->output.double_points;
+
+                array = v8::Array::New(isolate, static_cast<int>(points.size()));
+                if (array.IsEmpty())
+                {
+                    error_code = Error::MakeError(isolate, qdb_e_no_memory_local);
+                }
+                else
+                {
+                    for (size_t i = 0; i < points.size(); ++i)
+                    {
+                        auto obj = DoublePoint::MakePoint(isolate, points[i].timestamp, points[i].value);
+                        if (!obj.IsEmpty()) array->Set(isolate->GetCurrentContext(), static_cast<uint32_t>(i), obj);
+                    }
+                }
+            }
+            else
+            {
+                // provide an empty array
+                array = v8::Array::New(isolate, 0);
+            }
+
+            return make_value_array(error_code, array);
+        });
+}
+
+void DoubleColumn::processDoubleColumnarAggregateResult(uv_work_t * req, int status)
+{
+    processResult<2>(req, status,
+        [&](v8::Isolate * isolate, qdb_request * qdb_req)
+        {
+            auto error_code = processErrorCode(isolate, status, qdb_req);
+
+            // provide empty arrays on error
+            const auto & aggrs = qdb_req->input.content.double_aggrs;
+            const size_t count = ((qdb_req->output.error == qdb_e_ok) && (status >= 0)) ? aggrs.size() : 0u;
+
+            auto result = MakeColumnarAggregates<v8::Float64Array, double>(isolate, aggrs.data(), count,
+                [](const qdb_ts_double_point & point) { return point.value; });
+
+            return make_value_array(error_code, result);
+        });
+}
+
 void DoubleColumn::processDoubleAggregateResult(uv_work_t * req, int status)
 {
     processResult<2>(req, status,
@@ -441,10 +727,8 @@ void DoubleColumn::processDoubleAggregateResult(uv_work_t * req, int status)
                 }
                 else
                 {
-                    auto resprop =
-                        v8::String::NewFromUtf8(isolate, "result", v8::NewStringType::kNormal).ToLocalChecked();
-                    auto cntprop =
-                        v8::String::NewFromUtf8(isolate, "count", v8::NewStringType::kNormal).ToLocalChecked();
+                    auto resprop = property_key(isolate, key::result);
+                    auto cntprop = property_key(isolate, key::count);
 
                     for (size_t i = 0; i < aggrs.size(); ++i)
                     {
@@ -491,7 +775,30 @@ void Int64Column::insert(const v8::FunctionCallbackInfo<v8::Value> & args)
                 qdb_req->output.error = qdb_ts_int64_insert(qdb_req->handle(), ts, alias, points.data(), points.size());
             }
         },
-        Entry<Column>::processVoidResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::int64Points);
+        Entry<Column>::processVoidResult, &ArgsEaterBinder::int64Points);
+}
+
+void Int64Column::insertColumnar(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Column<Int64Column>::queue_work(
+        args,
+        [](qdb_request * qdb_req)
+        {
+            const auto alias = qdb_req->input.alias.c_str();
+            const auto ts = qdb_req->input.content.str.c_str();
+            auto & points = qdb_req->input.content.int64_points;
+
+            // the conversion happens here, the JS thread only captured the typed arrays
+            if (!detail::columnar_to_points<int64_t>(qdb_req->input.content.columnar, points,
+                    [](qdb_ts_int64_point & p, int64_t v) { p.value = v; }))
+            {
+                qdb_req->output.error = qdb_e_invalid_argument;
+                return;
+            }
+
+            qdb_req->output.error = qdb_ts_int64_insert(qdb_req->handle(), ts, alias, points.data(), points.size());
+        },
+        Entry<Column>::processVoidResult, &ArgsEaterBinder::int64ColumnarPoints);
 }
 
 void Int64Column::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
@@ -510,10 +817,32 @@ void Int64Column::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
             qdb_req->output.error =
                 qdb_ts_int64_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), bufp, count);
         },
-        Int64Column::processInt64PointArrayResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::ranges);
+        Int64Column::processInt64PointArrayResult, &ArgsEaterBinder::ranges);
+}
+
+void Int64Column::executeAggregate(qdb_request * qdb_req)
+{
+    const auto alias = qdb_req->input.alias.c_str();
+    const auto ts = qdb_req->input.content.str.c_str();
+    qdb_ts_int64_aggregation_t * aggrs = qdb_req->input.content.int64_aggrs.data();
+    const qdb_size_t count = qdb_req->input.content.int64_aggrs.size();
+
+    qdb_req->output.error = qdb_ts_int64_aggregate(qdb_req->handle(), ts, alias, aggrs, count);
 }
 
 void Int64Column::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Int64Column::queue_work(args, Int64Column::executeAggregate, Int64Column::processInt64AggregateResult,
+        &ArgsEaterBinder::int64Aggregations);
+}
+
+void Int64Column::aggregateColumnar(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Int64Column::queue_work(args, Int64Column::executeAggregate, Int64Column::processInt64ColumnarAggregateResult,
+        &ArgsEaterBinder::int64Aggregations);
+}
+
+void Int64Column::compute(const v8::FunctionCallbackInfo<v8::Value> & args)
 {
     Int64Column::queue_work(
         args,
@@ -521,12 +850,28 @@ void Int64Column::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
         {
             const auto alias = qdb_req->input.alias.c_str();
             const auto ts = qdb_req->input.content.str.c_str();
-            qdb_ts_int64_aggregation_t * aggrs = qdb_req->input.content.int64_aggrs.data();
-            const qdb_size_t count = qdb_req->input.content.int64_aggrs.size();
+            const auto & ranges = qdb_req->input.content.ranges;
+            const auto & kernels = qdb_req->input.content.kernels;
+
+            if (kernels.empty())
+            {
+                qdb_req->output.error = qdb_e_invalid_argument;
+                return;
+            }
 
-            qdb_req->output.error = qdb_ts_int64_aggregate(qdb_req->handle(), ts, alias, aggrs, count);
+            qdb_ts_int64_point * points = nullptr;
+            qdb_size_t count = 0;
+
+            qdb_req->output.error =
+                qdb_ts_int64_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), &points, &count);
+            if (qdb_req->output.error == qdb_e_ok)
+            {
+                run_kernels(points, count, kernels, qdb_req->output.kernels);
+            }
+
+            qdb_release(qdb_req->handle(), points);
         },
-        Int64Column::processInt64AggregateResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::int64Aggregations);
+        Column<Int64Column>::processKernelResult, &ArgsEaterBinder::ranges, &ArgsEaterBinder::kernels);
 }
 
 void Int64Column::processInt64PointArrayResult(uv_work_t * req, int status)
@@ -570,6 +915,24 @@ void Int64Column::processInt64PointArrayResult(uv_work_t * req, int status)
         });
 }
 
+void Int64Column::processInt64ColumnarAggregateResult(uv_work_t * req, int status)
+{
+    processResult<2>(req, status,
+        [&](v8::Isolate * isolate, qdb_request * qdb_req)
+        {
+            auto error_code = processErrorCode(isolate, status, qdb_req);
+
+            // provide empty arrays on error
+            const auto & aggrs = qdb_req->input.content.int64_aggrs;
+            const size_t count = ((qdb_req->output.error == qdb_e_ok) && (status >= 0)) ? aggrs.size() : 0u;
+
+            auto result = MakeColumnarAggregates<v8::BigInt64Array, int64_t>(isolate, aggrs.data(), count,
+                [](const qdb_ts_int64_point & point) { return static_cast<int64_t>(point.value); });
+
+            return make_value_array(error_code, result);
+        });
+}
+
 void Int64Column::processInt64AggregateResult(uv_work_t * req, int status)
 {
     processResult<2>(req, status,
@@ -588,10 +951,8 @@ void Int64Column::processInt64AggregateResult(uv_work_t * req, int status)
                 }
                 else
                 {
-                    auto resprop =
-                        v8::String::NewFromUtf8(isolate, "result", v8::NewStringType::kNormal).ToLocalChecked();
-                    auto cntprop =
-                        v8::String::NewFromUtf8(isolate, "count", v8::NewStringType::kNormal).ToLocalChecked();
+                    auto resprop = property_key(isolate, key::result);
+                    auto cntprop = property_key(isolate, key::count);
 
                     for (size_t i = 0; i < aggrs.size(); ++i)
                     {
@@ -639,7 +1000,30 @@ void TimestampColumn::insert(const v8::FunctionCallbackInfo<v8::Value> & args)
                     qdb_ts_timestamp_insert(qdb_req->handle(), ts, alias, points.data(), points.size());
             }
         },
-        Entry<Column>::processVoidResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::timestampPoints);
+        Entry<Column>::processVoidResult, &ArgsEaterBinder::timestampPoints);
+}
+
+void TimestampColumn::insertColumnar(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    Column<TimestampColumn>::queue_work(
+        args,
+        [](qdb_request * qdb_req)
+        {
+            const auto alias = qdb_req->input.alias.c_str();
+            const auto ts = qdb_req->input.content.str.c_str();
+            auto & points = qdb_req->input.content.timestamp_points;
+
+            // the conversion happens here, the JS thread only captured the typed arrays
+            if (!detail::columnar_to_points<int64_t>(qdb_req->input.content.columnar, points,
+                    [](qdb_ts_timestamp_point & p, int64_t v) { p.value = ns_to_qdb_timespec(v); }))
+            {
+                qdb_req->output.error = qdb_e_invalid_argument;
+                return;
+            }
+
+            qdb_req->output.error = qdb_ts_timestamp_insert(qdb_req->handle(), ts, alias, points.data(), points.size());
+        },
+        Entry<Column>::processVoidResult, &ArgsEaterBinder::timestampColumnarPoints);
 }
 
 void TimestampColumn::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
@@ -658,24 +1042,29 @@ void TimestampColumn::ranges(const v8::FunctionCallbackInfo<v8::Value> & args)
             qdb_req->output.error =
                 qdb_ts_timestamp_get_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), bufp, count);
         },
-        TimestampColumn::processTimestampPointArrayResult, &ArgsEaterBinder::tsAlias, &ArgsEaterBinder::ranges);
+        TimestampColumn::processTimestampPointArrayResult, &ArgsEaterBinder::ranges);
+}
+
+void TimestampColumn::executeAggregate(qdb_request * qdb_req)
+{
+    const auto alias = qdb_req->input.alias.c_str();
+    const auto ts = qdb_req->input.content.str.c_str();
+    qdb_ts_timestamp_aggregation_t * aggrs = qdb_req->input.content.timestamp_aggrs.data();
+    const qdb_size_t count = qdb_req->input.content.timestamp_aggrs.size();
+
+    qdb_req->output.error = qdb_ts_timestamp_aggregate(qdb_req->handle(), ts, alias, aggrs, count);
 }
 
 void TimestampColumn::aggregate(const v8::FunctionCallbackInfo<v8::Value> & args)
 {
-    TimestampColumn::queue_work(
-        args,
-        [](qdb_request * qdb_req)
-        {
-            const auto alias = qdb_req->input.alias.c_str();
-            const auto ts = qdb_req->input.content.str.c_str();
-            qdb_ts_timestamp_aggregation_t * aggrs = qdb_req->input.content.timestamp_aggrs.data();
-            const qdb_size_t count = qdb_req->input.content.timestamp_aggrs.size();
+    TimestampColumn::queue_work(args, TimestampColumn::executeAggregate,
+        TimestampColumn::processTimestampAggregateResult, &ArgsEaterBinder::timestampAggregations);
+}
 
-            qdb_req->output.error = qdb_ts_timestamp_aggregate(qdb_req->handle(), ts, alias, aggrs, count);
-        },
-        TimestampColumn::processTimestampAggregateResult, &ArgsEaterBinder::tsAlias,
-        &ArgsEaterBinder::timestampAggregations);
+void TimestampColumn::aggregateColumnar(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    TimestampColumn::queue_work(args, TimestampColumn::executeAggregate,
+        TimestampColumn::processTimestampColumnarAggregateResult, &ArgsEaterBinder::timestampAggregations);
 }
 
 void TimestampColumn::processTimestampPointArrayResult(uv_work_t * req, int status)
@@ -719,6 +1108,24 @@ void TimestampColumn::processTimestampPointArrayResult(uv_work_t * req, int stat
         });
 }
 
+void TimestampColumn::processTimestampColumnarAggregateResult(uv_work_t * req, int status)
+{
+    processResult<2>(req, status,
+        [&](v8::Isolate * isolate, qdb_request * qdb_req)
+        {
+            auto error_code = processErrorCode(isolate, status, qdb_req);
+
+            // provide empty arrays on error
+            const auto & aggrs = qdb_req->input.content.timestamp_aggrs;
+            const size_t count = ((qdb_req->output.error == qdb_e_ok) && (status >= 0)) ? aggrs.size() : 0u;
+
+            auto result = MakeColumnarAggregates<v8::BigInt64Array, int64_t>(isolate, aggrs.data(), count,
+                [](const qdb_ts_timestamp_point & point) { return qdb_timespec_to_ns(point.value); });
+
+            return make_value_array(error_code, result);
+        });
+}
+
 void TimestampColumn::processTimestampAggregateResult(uv_work_t * req, int status)
 {
     processResult<2>(req, status,
@@ -737,10 +1144,8 @@ void TimestampColumn::processTimestampAggregateResult(uv_work_t * req, int statu
                 }
                 else
                 {
-                    auto resprop =
-                        v8::String::NewFromUtf8(isolate, "result", v8::NewStringType::kNormal).ToLocalChecked();
-                    auto cntprop =
-                        v8::String::NewFromUtf8(isolate, "count", v8::NewStringType::kNormal).ToLocalChecked();
+                    auto resprop = property_key(isolate, key::result);
+                    auto cntprop = property_key(isolate, key::count);
 
                     for (size_t i = 0; i < aggrs.size(); ++i)
                     {
@@ -774,8 +1179,9 @@ std::pair<v8::Local<v8::Object>, bool> CreateColumn(
     case qdb_ts_column_blob:
         return std::make_pair(BlobColumn::MakeColumn(isolate, owner, name), true);
     case qdb_ts_column_string:
-    case qdb_ts_column_symbol:
         return std::make_pair(StringColumn::MakeColumn(isolate, owner, name), true);
+    case qdb_ts_column_symbol:
+        return std::make_pair(SymbolColumn::MakeColumn(isolate, owner, name), true);
     case qdb_ts_column_double:
         return std::make_pair(DoubleColumn::MakeColumn(isolate, owner, name), true);
     case qdb_ts_column_timestamp:
@@ -2,6 +2,7 @@
 
 #include "entry.hpp"
 #include "time_series.hpp"
+#include "ts_writer.hpp"
 #include "utilities.hpp"
 #include <qdb/ts.h>
 #include <node.h>
@@ -27,7 +28,7 @@ class Column : public Entry<Derivate>
 public:
     Column(cluster_data_ptr cd, const char * name, const char * ts, qdb_ts_column_type_t type)
         : Entry<Derivate>(cd, name)
-        , ts(ts)
+        , ts(std::make_shared<const std::string>(ts))
         , type(type)
 
     {
@@ -46,7 +47,8 @@ public:
                 // call init function of derivate
                 init(tpl);
 
-                NODE_SET_PROTOTYPE_METHOD(tpl, "erase", Column<Derivate>::erase);
+                detail::SetOperation(tpl, "erase", Column<Derivate>::erase);
+                detail::SetOperation(tpl, "writer", Column<Derivate>::writer);
 
                 v8::Isolate * isolate = exports->GetIsolate();
 
@@ -81,32 +83,157 @@ public:
 
     std::string timeSeries(void) const
     {
-        return ts;
+        return *ts;
     }
 
-private:
-    static void erase(const v8::FunctionCallbackInfo<v8::Value> & args)
+protected:
+    // Same as Entry::queue_work, but binds the time series alias cached at construction to the request instead of
+    // reading the "timeseries" property back from the JS object on every call.
+    template <typename F, typename... Params>
+    static void queue_work(
+        const v8::FunctionCallbackInfo<v8::Value> & args, F f, uv_after_work_cb after_work_cb, Params... p)
     {
-        MethodMan call(args);
-
-        Derivate * c = call.nativeHolder<Derivate>();
+        Derivate * c = node::ObjectWrap::Unwrap<Derivate>(args.Holder());
         assert(c);
 
-        auto ts = c->timeSeries();
+        std::shared_ptr<const std::string> ts = c->ts;
+        Entry<Derivate>::queue_work(
+            args,
+            [ts, f](qdb_request * qdb_req)
+            {
+                qdb_req->input.content.str = *ts;
+                f(qdb_req);
+            },
+            after_work_cb, p...);
+    }
+
+    // Builds {values, counts, timestamps} typed arrays indexed like the aggregations, without a point object per
+    // result. Timestamps are nanoseconds since epoch.
+    template <typename ValuesArray, typename Element, typename Aggregation, typename Getter>
+    static v8::Local<v8::Object> MakeColumnarAggregates(
+        v8::Isolate * isolate, const Aggregation * aggrs, size_t count, Getter value_of)
+    {
+        auto context = isolate->GetCurrentContext();
+
+        Element * values;
+        double * counts;
+        int64_t * timestamps;
+
+        auto values_array = detail::NewTypedArray<ValuesArray>(isolate, count, values);
+        auto counts_array = detail::NewTypedArray<v8::Float64Array>(isolate, count, counts);
+        auto timestamps_array = detail::NewTypedArray<v8::BigInt64Array>(isolate, count, timestamps);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = value_of(aggrs[i].result);
+            counts[i] = static_cast<double>(aggrs[i].count);
+            timestamps[i] = qdb_timespec_to_ns(aggrs[i].result.timestamp);
+        }
+
+        auto obj = v8::Object::New(isolate);
+        obj->Set(context, property_key(isolate, key::values), values_array);
+        obj->Set(context, property_key(isolate, key::counts), counts_array);
+        obj->Set(context, property_key(isolate, key::timestamps), timestamps_array);
+
+        return obj;
+    }
+
+    // numbers for percentile, ewma and rate, {min, max, counts} objects for histograms
+    static void processKernelResult(uv_work_t * req, int status)
+    {
+        Entry<Derivate>::template processResult<2>(req, status,
+            [&](v8::Isolate * isolate, qdb_request * qdb_req)
+            {
+                v8::Local<v8::Array> array;
+
+                auto error_code = Entry<Derivate>::processErrorCode(isolate, status, qdb_req);
+                if ((qdb_req->output.error == qdb_e_ok) && (status >= 0))
+                {
+                    const auto & specs = qdb_req->input.content.kernels;
+                    const auto & results = qdb_req->output.kernels;
+                    auto context = isolate->GetCurrentContext();
+
+                    array = v8::Array::New(isolate, static_cast<int>(results.size()));
+                    if (array.IsEmpty())
+                    {
+                        error_code = Error::MakeError(isolate, qdb_e_no_memory_local);
+                    }
+                    else
+                    {
+                        auto minProp = property_key(isolate, key::minimum);
+                        auto maxProp = property_key(isolate, key::maximum);
+                        auto countsProp = property_key(isolate, key::counts);
+
+                        for (size_t i = 0; i < results.size(); ++i)
+                        {
+                            const auto & res = results[i];
+                            v8::Local<v8::Value> value;
+
+                            if (specs[i].op == kernel_op::histogram)
+                            {
+                                auto counts = v8::Array::New(isolate, static_cast<int>(res.counts.size()));
+                                for (size_t j = 0; j < res.counts.size(); ++j)
+                                {
+                                    counts->Set(context, static_cast<uint32_t>(j),
+                                        v8::Number::New(isolate, static_cast<double>(res.counts[j])));
+                                }
+
+                                auto obj = v8::Object::New(isolate);
+                                obj->Set(context, minProp, v8::Number::New(isolate, res.min));
+                                obj->Set(context, maxProp, v8::Number::New(isolate, res.max));
+                                obj->Set(context, countsProp, counts);
+                                value = obj;
+                            }
+                            else
+                            {
+                                value = v8::Number::New(isolate, res.value);
+                            }
+
+                            array->Set(context, static_cast<uint32_t>(i), value);
+                        }
+                    }
+                }
+                else
+                {
+                    // provide an empty array
+                    array = v8::Array::New(isolate, 0);
+                }
+
+                return make_value_array(error_code, array);
+            });
+    }
+
+private:
+    static void erase(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
         Column<Derivate>::queue_work(
             args,
-            [ts](qdb_request * qdb_req)
+            [](qdb_request * qdb_req)
             {
                 auto & ranges = qdb_req->input.content.ranges;
                 auto erased = &qdb_req->output.content.uvalue;
                 auto alias = qdb_req->input.alias.c_str();
+                auto ts = qdb_req->input.content.str.c_str();
 
                 qdb_req->output.error =
-                    qdb_ts_erase_ranges(qdb_req->handle(), ts.c_str(), alias, ranges.data(), ranges.size(), erased);
+                    qdb_ts_erase_ranges(qdb_req->handle(), ts, alias, ranges.data(), ranges.size(), erased);
             },
             Column<Derivate>::processUintegerResult, &ArgsEaterBinder::ranges);
     }
 
+    // :desc: Returns a writer bound to this column, which reuses its native request state between inserts.
+    // :returns: A ColumnWriter object
+    static void writer(const v8::FunctionCallbackInfo<v8::Value> & args)
+    {
+        MethodMan call(args);
+
+        Derivate * c = call.nativeHolder<Derivate>();
+        assert(c);
+
+        args.GetReturnValue().Set(
+            ColumnWriter::MakeWriter(args.GetIsolate(), c->cluster_data(), *c->ts, c->native_alias(), c->type));
+    }
+
     static void NewInstance(const v8::FunctionCallbackInfo<v8::Value> & args)
     {
         v8::Isolate * isolate = args.GetIsolate();
@@ -182,7 +309,7 @@ private:
             {
                 v8::Isolate * isolate = args.GetIsolate();
                 args.GetReturnValue().Set(
-                    v8::String::NewFromUtf8(isolate, c->ts.c_str(), v8::NewStringType::kNormal, c->ts.size())
+                    v8::String::NewFromUtf8(isolate, c->ts->c_str(), v8::NewStringType::kNormal, c->ts->size())
                         .ToLocalChecked());
             });
     }
@@ -198,7 +325,8 @@ private:
     }
 
 private:
-    std::string ts;
+    // shared with the requests in flight
+    std::shared_ptr<const std::string> ts;
     qdb_ts_column_type_t type;
 };
 
@@ -222,19 +350,31 @@ public:
         Column<DoubleColumn>::Init(exports, "DoubleColumn",
             [](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "insert", DoubleColumn::insert);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "ranges", DoubleColumn::ranges);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "aggregate", DoubleColumn::aggregate);
+                detail::SetOperation(tpl, "insert", DoubleColumn::insert);
+                detail::SetOperation(tpl, "insertColumnar", DoubleColumn::insertColumnar);
+                detail::SetOperation(tpl, "ranges", DoubleColumn::ranges);
+                detail::SetOperation(tpl, "rangesDownsampled", DoubleColumn::rangesDownsampled);
+                detail::SetOperation(tpl, "aggregate", DoubleColumn::aggregate);
+                detail::SetOperation(tpl, "aggregateColumnar", DoubleColumn::aggregateColumnar);
+                detail::SetOperation(tpl, "compute", DoubleColumn::compute);
             });
     }
 
 private:
     static void insert(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void insertColumnar(const v8::FunctionCallbackInfo<v8::Value> & args);
     static void ranges(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void rangesDownsampled(const v8::FunctionCallbackInfo<v8::Value> & args);
     static void aggregate(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void aggregateColumnar(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void compute(const v8::FunctionCallbackInfo<v8::Value> & args);
 
     static void processDoublePointArrayResult(uv_work_t * req, int status);
+    static void processDownsampledResult(uv_work_t * req, int status);
     static void processDoubleAggregateResult(uv_work_t * req, int status);
+    static void processDoubleColumnarAggregateResult(uv_work_t * req, int status);
+
+    static void executeAggregate(qdb_request * qdb_req);
 
     static v8::Persistent<v8::Function> constructor;
 };
@@ -259,9 +399,9 @@ public:
         Column<BlobColumn>::Init(exports, "BlobColumn",
             [](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "insert", BlobColumn::insert);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "ranges", BlobColumn::ranges);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "aggregate", BlobColumn::aggregate);
+                detail::SetOperation(tpl, "insert", BlobColumn::insert);
+                detail::SetOperation(tpl, "ranges", BlobColumn::ranges);
+                detail::SetOperation(tpl, "aggregate", BlobColumn::aggregate);
             });
     }
 
@@ -280,6 +420,7 @@ class StringColumn : public Column<StringColumn>
 {
     friend class Column<StringColumn>;
     friend class Entry<StringColumn>;
+    friend class SymbolColumn;
 
     StringColumn(cluster_data_ptr cd, const char * name, const char * ts)
         : Column<StringColumn>(cd, name, ts, qdb_ts_column_string)
@@ -296,20 +437,66 @@ public:
         Column<StringColumn>::Init(exports, "StringColumn",
             [](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "insert", StringColumn::insert);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "ranges", StringColumn::ranges);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "aggregate", StringColumn::aggregate);
+                detail::SetOperation(tpl, "insert", StringColumn::insert);
+                detail::SetOperation(tpl, "ranges", StringColumn::ranges);
+                detail::SetOperation(tpl, "rangesColumnar", StringColumn::rangesColumnar);
+                detail::SetOperation(tpl, "aggregate", StringColumn::aggregate);
             });
     }
 
 private:
     static void insert(const v8::FunctionCallbackInfo<v8::Value> & args);
     static void ranges(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void rangesColumnar(const v8::FunctionCallbackInfo<v8::Value> & args);
     static void aggregate(const v8::FunctionCallbackInfo<v8::Value> & args);
 
     static void processStringPointArrayResult(uv_work_t * req, int status);
+    static void processStringColumnarResult(uv_work_t * req, int status);
     static void processStringAggregateResult(uv_work_t * req, int status);
 
+    static void executeInsert(qdb_request * qdb_req);
+    static void executeRanges(qdb_request * qdb_req);
+    static void executeRangesColumnar(qdb_request * qdb_req);
+    static void executeAggregate(qdb_request * qdb_req);
+
+    static v8::Persistent<v8::Function> constructor;
+};
+
+// Symbol columns hold strings through a symbol table, they share the calls and the point format of string columns
+// and report the string column type. StringColumn is the prototype of SymbolColumn, see index.js.
+class SymbolColumn : public Column<SymbolColumn>
+{
+    friend class Column<SymbolColumn>;
+    friend class Entry<SymbolColumn>;
+
+    SymbolColumn(cluster_data_ptr cd, const char * name, const char * ts)
+        : Column<SymbolColumn>(cd, name, ts, qdb_ts_column_string)
+    {
+    }
+
+    virtual ~SymbolColumn(void)
+    {
+    }
+
+public:
+    static void Init(v8::Local<v8::Object> exports)
+    {
+        Column<SymbolColumn>::Init(exports, "SymbolColumn",
+            [](v8::Local<v8::FunctionTemplate> tpl)
+            {
+                detail::SetOperation(tpl, "insert", SymbolColumn::insert);
+                detail::SetOperation(tpl, "ranges", SymbolColumn::ranges);
+                detail::SetOperation(tpl, "rangesColumnar", SymbolColumn::rangesColumnar);
+                detail::SetOperation(tpl, "aggregate", SymbolColumn::aggregate);
+            });
+    }
+
+private:
+    static void insert(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void ranges(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void rangesColumnar(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void aggregate(const v8::FunctionCallbackInfo<v8::Value> & args);
+
     static v8::Persistent<v8::Function> constructor;
 };
 
@@ -333,19 +520,28 @@ public:
         Column<Int64Column>::Init(exports, "Int64Column",
             [](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "insert", Int64Column::insert);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "ranges", Int64Column::ranges);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "aggregate", Int64Column::aggregate);
+                detail::SetOperation(tpl, "insert", Int64Column::insert);
+                detail::SetOperation(tpl, "insertColumnar", Int64Column::insertColumnar);
+                detail::SetOperation(tpl, "ranges", Int64Column::ranges);
+                detail::SetOperation(tpl, "aggregate", Int64Column::aggregate);
+                detail::SetOperation(tpl, "aggregateColumnar", Int64Column::aggregateColumnar);
+                detail::SetOperation(tpl, "compute", Int64Column::compute);
             });
     }
 
 private:
     static void insert(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void insertColumnar(const v8::FunctionCallbackInfo<v8::Value> & args);
     static void ranges(const v8::FunctionCallbackInfo<v8::Value> & args);
     static void aggregate(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void aggregateColumnar(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void compute(const v8::FunctionCallbackInfo<v8::Value> & args);
 
     static void processInt64PointArrayResult(uv_work_t * req, int status);
     static void processInt64AggregateResult(uv_work_t * req, int status);
+    static void processInt64ColumnarAggregateResult(uv_work_t * req, int status);
+
+    static void executeAggregate(qdb_request * qdb_req);
 
     static v8::Persistent<v8::Function> constructor;
 };
@@ -370,19 +566,26 @@ public:
         Column<TimestampColumn>::Init(exports, "TimestampColumn",
             [](v8::Local<v8::FunctionTemplate> tpl)
             {
-                NODE_SET_PROTOTYPE_METHOD(tpl, "insert", TimestampColumn::insert);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "ranges", TimestampColumn::ranges);
-                NODE_SET_PROTOTYPE_METHOD(tpl, "aggregate", TimestampColumn::aggregate);
+                detail::SetOperation(tpl, "insert", TimestampColumn::insert);
+                detail::SetOperation(tpl, "insertColumnar", TimestampColumn::insertColumnar);
+                detail::SetOperation(tpl, "ranges", TimestampColumn::ranges);
+                detail::SetOperation(tpl, "aggregate", TimestampColumn::aggregate);
+                detail::SetOperation(tpl, "aggregateColumnar", TimestampColumn::aggregateColumnar);
             });
     }
 
 private:
     static void insert(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void insertColumnar(const v8::FunctionCallbackInfo<v8::Value> & args);
     static void ranges(const v8::FunctionCallbackInfo<v8::Value> & args);
     static void aggregate(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void aggregateColumnar(const v8::FunctionCallbackInfo<v8::Value> & args);
 
     static void processTimestampPointArrayResult(uv_work_t * req, int status);
     static void processTimestampAggregateResult(uv_work_t * req, int status);
+    static void processTimestampColumnarAggregateResult(uv_work_t * req, int status);
+
+    static void executeAggregate(qdb_request * qdb_req);
 
     static v8::Persistent<v8::Function> constructor;
 };
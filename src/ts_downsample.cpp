@@ -0,0 +1,207 @@
+#include "ts_downsample.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace quasardb
+{
+namespace detail
+{
+
+// The points are stored as an array of structures, gather them into flat arrays first so that the inner loops below
+// work on contiguous doubles the compiler can vectorize.
+struct flat_series
+{
+    flat_series(const qdb_ts_double_point * points, size_t count)
+        : x(count)
+        , y(count)
+    {
+        if (!count) return;
+
+        const qdb_time_t origin = points[0].timestamp.tv_sec;
+        for (size_t i = 0; i < count; ++i)
+        {
+            x[i] = static_cast<double>(points[i].timestamp.tv_sec - origin)
+                   + static_cast<double>(points[i].timestamp.tv_nsec) * 1e-9;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            y[i] = points[i].value;
+        }
+    }
+
+    std::vector<double> x;
+    std::vector<double> y;
+};
+
+// [begin, end) indices of the bucket number `i` when `count` points are split into `buckets` consecutive buckets
+inline std::pair<size_t, size_t> bucket_bounds(size_t i, size_t count, size_t buckets)
+{
+    return std::make_pair(i * count / buckets, (i + 1) * count / buckets);
+}
+
+static void downsample_lttb(const qdb_ts_double_point * points,
+    size_t count,
+    size_t threshold,
+    std::vector<qdb_ts_double_point> & result)
+{
+    const flat_series s(points, count);
+    const double * x = s.x.data();
+    const double * y = s.y.data();
+
+    result.reserve(threshold);
+
+    // the first and the last points are always part of the result, the others are split into threshold - 2 buckets
+    const size_t inner = count - 2;
+    const size_t buckets = threshold - 2;
+
+    size_t a = 0;
+    result.push_back(points[a]);
+
+    for (size_t i = 0; i < buckets; ++i)
+    {
+        const auto current = bucket_bounds(i, inner, buckets);
+
+        // average of the next bucket, the last point if we are in the last bucket
+        double avg_x = x[count - 1];
+        double avg_y = y[count - 1];
+        if (i + 1 < buckets)
+        {
+            const auto next = bucket_bounds(i + 1, inner, buckets);
+            double sum_x = 0.0;
+            double sum_y = 0.0;
+            for (size_t j = next.first + 1; j < next.second + 1; ++j)
+            {
+                sum_x += x[j];
+                sum_y += y[j];
+            }
+            const double n = static_cast<double>(next.second - next.first);
+            avg_x = sum_x / n;
+            avg_y = sum_y / n;
+        }
+
+        // keep the point forming the largest triangle with the previously selected point and the next average
+        const double ax = x[a];
+        const double ay = y[a];
+        const double dx = avg_x - ax;
+        const double dy = avg_y - ay;
+
+        size_t selected = current.first + 1;
+        double max_area = -1.0;
+        for (size_t j = current.first + 1; j < current.second + 1; ++j)
+        {
+            const double area = std::abs((x[j] - ax) * dy - dx * (y[j] - ay));
+            if (area > max_area)
+            {
+                max_area = area;
+                selected = j;
+            }
+        }
+
+        result.push_back(points[selected]);
+        a = selected;
+    }
+
+    result.push_back(points[count - 1]);
+}
+
+static void downsample_minmax(const qdb_ts_double_point * points,
+    size_t count,
+    size_t buckets,
+    std::vector<qdb_ts_double_point> & result)
+{
+    const flat_series s(points, count);
+    const double * y = s.y.data();
+
+    result.reserve(2 * buckets);
+
+    for (size_t i = 0; i < buckets; ++i)
+    {
+        const auto bounds = bucket_bounds(i, count, buckets);
+
+        size_t min_idx = bounds.first;
+        size_t max_idx = bounds.first;
+        for (size_t j = bounds.first + 1; j < bounds.second; ++j)
+        {
+            min_idx = (y[j] < y[min_idx]) ? j : min_idx;
+            max_idx = (y[j] > y[max_idx]) ? j : max_idx;
+        }
+
+        // preserve the time ordering of the output
+        result.push_back(points[std::min(min_idx, max_idx)]);
+        if (min_idx != max_idx)
+        {
+            result.push_back(points[std::max(min_idx, max_idx)]);
+        }
+    }
+}
+
+static void downsample_avg(const qdb_ts_double_point * points,
+    size_t count,
+    size_t buckets,
+    std::vector<qdb_ts_double_point> & result)
+{
+    const flat_series s(points, count);
+    const double * y = s.y.data();
+
+    result.reserve(buckets);
+
+    for (size_t i = 0; i < buckets; ++i)
+    {
+        const auto bounds = bucket_bounds(i, count, buckets);
+
+        double sum = 0.0;
+        for (size_t j = bounds.first; j < bounds.second; ++j)
+        {
+            sum += y[j];
+        }
+
+        qdb_ts_double_point p;
+        p.timestamp = points[bounds.first].timestamp;
+        p.value = sum / static_cast<double>(bounds.second - bounds.first);
+        result.push_back(p);
+    }
+}
+
+} // namespace detail
+
+downsample_method downsample_method_from_string(const std::string & name)
+{
+    if (name == "lttb") return downsample_method::lttb;
+    if (name == "minmax") return downsample_method::minmax;
+    if (name == "avg") return downsample_method::avg;
+
+    return downsample_method::invalid;
+}
+
+void downsample(const qdb_ts_double_point * points,
+    size_t count,
+    const downsample_options & options,
+    std::vector<qdb_ts_double_point> & result)
+{
+    result.clear();
+
+    const size_t max_output = (options.method == downsample_method::minmax) ? 2 * options.buckets : options.buckets;
+    if (count <= max_output)
+    {
+        result.assign(points, points + count);
+        return;
+    }
+
+    switch (options.method)
+    {
+    case downsample_method::lttb:
+        detail::downsample_lttb(points, count, options.buckets, result);
+        break;
+    case downsample_method::minmax:
+        detail::downsample_minmax(points, count, options.buckets, result);
+        break;
+    case downsample_method::avg:
+        detail::downsample_avg(points, count, options.buckets, result);
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace quasardb
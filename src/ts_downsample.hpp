@@ -0,0 +1,65 @@
+#pragma once
+
+#include <qdb/ts.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace quasardb
+{
+
+enum class downsample_method
+{
+    invalid,
+    lttb,
+    minmax,
+    avg
+};
+
+// POD for storing downsampling parameters from js calls
+struct downsample_options
+{
+    downsample_options()
+        : method(downsample_method::invalid)
+        , buckets(0)
+    {
+    }
+
+    // bounds the memory of the result, same as the histogram buckets of the kernels
+    static const size_t max_buckets = 1000000;
+
+    downsample_method method;
+    size_t buckets;
+
+    bool valid() const
+    {
+        if (buckets > max_buckets) return false;
+
+        switch (method)
+        {
+        case downsample_method::lttb:
+            // first and last points are always kept, at least one bucket in between
+            return buckets >= 3;
+        case downsample_method::minmax:
+        case downsample_method::avg:
+            return buckets >= 1;
+        default:
+            return false;
+        }
+    }
+};
+
+downsample_method downsample_method_from_string(const std::string & name);
+
+// Reduces a time ordered series of points, as returned by qdb_ts_double_get_ranges, to at most:
+//  - lttb: `buckets` points (Largest-Triangle-Three-Buckets),
+//  - minmax: 2 * `buckets` points (minimum and maximum of each bucket, in time order),
+//  - avg: `buckets` points (mean value of each bucket, stamped with the first timestamp of the bucket).
+// Buckets are made of consecutive points. Series which are already small enough are returned unchanged.
+// Meant to be run on the worker thread, does not touch V8.
+void downsample(const qdb_ts_double_point * points,
+    size_t count,
+    const downsample_options & options,
+    std::vector<qdb_ts_double_point> & result);
+
+} // namespace quasardb
@@ -0,0 +1,306 @@
+#include "ts_kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define QDB_KERNELS_SSE2
+#    include <emmintrin.h>
+#endif
+
+#if defined(QDB_KERNELS_AVX2) && defined(_MSC_VER)
+#    include <immintrin.h>
+#    include <intrin.h>
+#endif
+
+namespace quasardb
+{
+
+bool kernel_spec::valid() const
+{
+    switch (op)
+    {
+    case kernel_op::percentile:
+        return (param >= 0.0) && (param <= 100.0);
+    case kernel_op::ewma:
+        return (param > 0.0) && (param <= 1.0);
+    case kernel_op::rate:
+        return true;
+    case kernel_op::histogram:
+        return (buckets > 0) && (buckets <= max_buckets)
+            && (!has_bounds || (std::isfinite(min) && std::isfinite(max) && (min < max)));
+    default:
+        return false;
+    }
+}
+
+kernel_op kernel_op_from_string(const std::string & name)
+{
+    if (name == "percentile") return kernel_op::percentile;
+    if (name == "ewma") return kernel_op::ewma;
+    if (name == "rate") return kernel_op::rate;
+    if (name == "histogram") return kernel_op::histogram;
+
+    return kernel_op::invalid;
+}
+
+namespace detail
+{
+
+#if defined(QDB_KERNELS_AVX2)
+// Whether the CPU, and the OS saving its registers, support AVX2. Built without AVX2, as is every caller of the AVX2
+// loops.
+static bool cpu_has_avx2()
+{
+#    if defined(_MSC_VER)
+    static const bool avx2 = []()
+    {
+        int info[4];
+        __cpuid(info, 1);
+
+        // AVX and OSXSAVE, then the OS saves the XMM and YMM registers
+        if ((info[2] & (1 << 27 | 1 << 28)) != (1 << 27 | 1 << 28)) return false;
+        if ((_xgetbv(0) & 6) != 6) return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+#    else
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+#    endif
+
+    return avx2;
+}
+#endif
+
+// The vector part of the kernels, from the first value. They return the count of values handled, the rest is left to
+// the scalar loops.
+
+static size_t kernel_minmax_vector(const double * values, size_t count, double & lo, double & hi)
+{
+#if defined(QDB_KERNELS_AVX2)
+    if (cpu_has_avx2()) return kernel_minmax_avx2(values, count, lo, hi);
+#endif
+
+#if defined(QDB_KERNELS_SSE2)
+    if (count < 2) return 0;
+
+    __m128d vlo = _mm_loadu_pd(values);
+    __m128d vhi = vlo;
+
+    size_t i = 2;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d v = _mm_loadu_pd(values + i);
+        vlo = _mm_min_pd(vlo, v);
+        vhi = _mm_max_pd(vhi, v);
+    }
+
+    double l[2];
+    double h[2];
+    _mm_storeu_pd(l, vlo);
+    _mm_storeu_pd(h, vhi);
+    lo = std::min(l[0], l[1]);
+    hi = std::max(h[0], h[1]);
+
+    return i;
+#else
+    (void)values;
+    (void)count;
+    (void)lo;
+    (void)hi;
+    return 0;
+#endif
+}
+
+static size_t kernel_histogram_vector(
+    const double * values, size_t count, double min, double max, double scale, double last, qdb_uint_t * counts)
+{
+#if defined(QDB_KERNELS_AVX2)
+    if (cpu_has_avx2()) return kernel_histogram_avx2(values, count, min, max, scale, last, counts);
+#endif
+
+#if defined(QDB_KERNELS_SSE2)
+    const __m128d vmin = _mm_set1_pd(min);
+    const __m128d vmax = _mm_set1_pd(max);
+    const __m128d vscale = _mm_set1_pd(scale);
+    const __m128d vlast = _mm_set1_pd(last);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d v = _mm_loadu_pd(values + i);
+        const __m128d in = _mm_and_pd(_mm_cmpge_pd(v, vmin), _mm_cmple_pd(v, vmax));
+        const int mask = _mm_movemask_pd(in);
+        if (!mask) continue;
+
+        const __m128d b = _mm_min_pd(_mm_mul_pd(_mm_sub_pd(v, vmin), vscale), vlast);
+
+        int32_t idx[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(idx), _mm_cvttpd_epi32(b));
+
+        if (mask & 1) ++counts[idx[0]];
+        if (mask & 2) ++counts[idx[1]];
+    }
+
+    return i;
+#else
+    (void)values;
+    (void)count;
+    (void)min;
+    (void)max;
+    (void)scale;
+    (void)last;
+    (void)counts;
+    return 0;
+#endif
+}
+
+} // namespace detail
+
+const char * kernel_simd_flavour()
+{
+#if defined(QDB_KERNELS_AVX2)
+    if (detail::cpu_has_avx2()) return "avx2";
+#endif
+
+#if defined(QDB_KERNELS_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void kernel_minmax(const double * values, size_t count, double & min, double & max)
+{
+    min = std::numeric_limits<double>::quiet_NaN();
+    max = std::numeric_limits<double>::quiet_NaN();
+    if (!count) return;
+
+    double lo = values[0];
+    double hi = values[0];
+
+    for (size_t i = detail::kernel_minmax_vector(values, count, lo, hi); i < count; ++i)
+    {
+        lo = (values[i] < lo) ? values[i] : lo;
+        hi = (values[i] > hi) ? values[i] : hi;
+    }
+
+    min = lo;
+    max = hi;
+}
+
+void kernel_histogram(
+    const double * values, size_t count, double min, double max, size_t buckets, qdb_uint_t * counts)
+{
+    // values outside of [min, max] are ignored, max falls into the last bucket, buckets is at most
+    // kernel_spec::max_buckets so that the indexes fit the 32 bits conversions
+    const double scale = (max > min) ? static_cast<double>(buckets) / (max - min) : 0.0;
+    const double last = static_cast<double>(buckets - 1);
+
+    for (size_t i = detail::kernel_histogram_vector(values, count, min, max, scale, last, counts); i < count; ++i)
+    {
+        const double v = values[i];
+        if (!((v >= min) && (v <= max))) continue;
+
+        // infinite values give a NaN position, counted in the last bucket as the vector paths do
+        const double b = (v - min) * scale;
+        ++counts[static_cast<size_t>((b < last) ? b : last)];
+    }
+}
+
+namespace detail
+{
+
+static double kernel_percentile(const std::vector<double> & values, double p)
+{
+    if (values.empty()) return std::numeric_limits<double>::quiet_NaN();
+
+    // linear interpolation between the closest ranks
+    std::vector<double> sorted(values);
+    const double rank = p / 100.0 * static_cast<double>(sorted.size() - 1);
+    const size_t lo = static_cast<size_t>(std::floor(rank));
+
+    std::nth_element(sorted.begin(), sorted.begin() + lo, sorted.end());
+    const double a = sorted[lo];
+    if (lo + 1 >= sorted.size()) return a;
+
+    // elements after the nth one are all greater or equal
+    const double b = *std::min_element(sorted.begin() + lo + 1, sorted.end());
+    return a + (b - a) * (rank - static_cast<double>(lo));
+}
+
+static double kernel_ewma(const std::vector<double> & values, double alpha)
+{
+    if (values.empty()) return std::numeric_limits<double>::quiet_NaN();
+
+    // inherently sequential, each step depends on the previous one
+    double s = values[0];
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        s += alpha * (values[i] - s);
+    }
+
+    return s;
+}
+
+static double kernel_rate(const kernel_input & input)
+{
+    const size_t count = input.values.size();
+    if (count < 2) return std::numeric_limits<double>::quiet_NaN();
+
+    const double dt = input.times[count - 1] - input.times[0];
+    if (dt <= 0.0) return std::numeric_limits<double>::quiet_NaN();
+
+    // per second
+    return (input.values[count - 1] - input.values[0]) / dt;
+}
+
+} // namespace detail
+
+kernel_result compute_kernel(const kernel_input & input, const kernel_spec & spec)
+{
+    kernel_result res;
+
+    switch (spec.op)
+    {
+    case kernel_op::percentile:
+        res.value = detail::kernel_percentile(input.values, spec.param);
+        break;
+
+    case kernel_op::ewma:
+        res.value = detail::kernel_ewma(input.values, spec.param);
+        break;
+
+    case kernel_op::rate:
+        res.value = detail::kernel_rate(input);
+        break;
+
+    case kernel_op::histogram:
+        res.counts.assign(spec.buckets, 0);
+        if (spec.has_bounds)
+        {
+            res.min = spec.min;
+            res.max = spec.max;
+        }
+        else
+        {
+            kernel_minmax(input.values.data(), input.values.size(), res.min, res.max);
+        }
+
+        if (!input.values.empty())
+        {
+            kernel_histogram(
+                input.values.data(), input.values.size(), res.min, res.max, spec.buckets, res.counts.data());
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return res;
+}
+
+} // namespace quasardb
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <qdb/ts.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace quasardb
+{
+
+enum class kernel_op
+{
+    invalid,
+    percentile,
+    ewma,
+    rate,
+    histogram
+};
+
+// POD for storing a client-side aggregation request from js calls
+struct kernel_spec
+{
+    kernel_spec()
+        : op(kernel_op::invalid)
+        , param(0.0)
+        , buckets(0)
+        , has_bounds(false)
+        , min(0.0)
+        , max(0.0)
+    {
+    }
+
+    kernel_op op;
+
+    // percentile: rank in [0, 100], ewma: smoothing factor in (0, 1]
+    double param;
+
+    // histogram only, at most max_buckets
+    static const size_t max_buckets = 1000000;
+
+    size_t buckets;
+    bool has_bounds;
+    double min;
+    double max;
+
+    bool valid() const;
+};
+
+struct kernel_result
+{
+    kernel_result()
+        : value(0.0)
+        , min(0.0)
+        , max(0.0)
+    {
+    }
+
+    // percentile, ewma, rate
+    double value;
+
+    // histogram only
+    double min;
+    double max;
+    std::vector<qdb_uint_t> counts;
+};
+
+kernel_op kernel_op_from_string(const std::string & name);
+
+// Flat copy of a point buffer, timestamps are expressed in seconds relative to the first point.
+struct kernel_input
+{
+    std::vector<double> times;
+    std::vector<double> values;
+};
+
+template <typename Point>
+void gather_points(const Point * points, size_t count, kernel_input & input)
+{
+    input.times.resize(count);
+    input.values.resize(count);
+    if (!count) return;
+
+    const qdb_time_t origin = points[0].timestamp.tv_sec;
+    for (size_t i = 0; i < count; ++i)
+    {
+        input.times[i] = static_cast<double>(points[i].timestamp.tv_sec - origin)
+                         + static_cast<double>(points[i].timestamp.tv_nsec) * 1e-9;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        input.values[i] = static_cast<double>(points[i].value);
+    }
+}
+
+// Runs a single kernel over the gathered series. Empty series give NaN values and histograms with zero counts.
+// Meant to be run on the worker thread, does not touch V8.
+kernel_result compute_kernel(const kernel_input & input, const kernel_spec & spec);
+
+template <typename Point>
+void run_kernels(const Point * points,
+    size_t count,
+    const std::vector<kernel_spec> & specs,
+    std::vector<kernel_result> & results)
+{
+    // gather once, every kernel works on the same flat copy
+    kernel_input input;
+    gather_points(points, count, input);
+
+    results.clear();
+    results.reserve(specs.size());
+    for (const auto & spec : specs)
+    {
+        results.push_back(compute_kernel(input, spec));
+    }
+}
+
+// Exposed for benchmarking. The SSE2 flavour is selected at compile time, the AVX2 one at run time when the addon is
+// built with enable_avx2 and the CPU supports it.
+void kernel_minmax(const double * values, size_t count, double & min, double & max);
+void kernel_histogram(
+    const double * values, size_t count, double min, double max, size_t buckets, qdb_uint_t * counts);
+
+// The SIMD flavour the kernels run with: avx2, sse2 or scalar.
+const char * kernel_simd_flavour();
+
+#if defined(QDB_KERNELS_AVX2)
+namespace detail
+{
+
+// In ts_kernels_avx2.cpp, only to be called when the CPU supports AVX2. They handle the values they return the count
+// of, from the first one, the rest is left to the caller.
+size_t kernel_minmax_avx2(const double * values, size_t count, double & lo, double & hi);
+size_t kernel_histogram_avx2(
+    const double * values, size_t count, double min, double max, double scale, double last, qdb_uint_t * counts);
+
+} // namespace detail
+#endif
+
+} // namespace quasardb
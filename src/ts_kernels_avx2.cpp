@@ -0,0 +1,77 @@
+// The AVX2 loops of the kernels, the only code built with AVX2 enabled, see enable_avx2 in binding.gyp. They are only
+// called once the CPU is known to support it, and stay away from the inline functions and templates shared with the
+// rest of the addon, which the linker could otherwise pick in their AVX2 flavour.
+#include "ts_kernels.hpp"
+#include <cstdint>
+#include <immintrin.h>
+
+namespace quasardb
+{
+
+namespace detail
+{
+
+size_t kernel_minmax_avx2(const double * values, size_t count, double & lo, double & hi)
+{
+    if (count < 4) return 0;
+
+    __m256d vlo = _mm256_loadu_pd(values);
+    __m256d vhi = vlo;
+
+    size_t i = 4;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d v = _mm256_loadu_pd(values + i);
+        vlo = _mm256_min_pd(vlo, v);
+        vhi = _mm256_max_pd(vhi, v);
+    }
+
+    double l[4];
+    double h[4];
+    _mm256_storeu_pd(l, vlo);
+    _mm256_storeu_pd(h, vhi);
+
+    lo = l[0];
+    hi = h[0];
+    for (int k = 1; k < 4; ++k)
+    {
+        lo = (l[k] < lo) ? l[k] : lo;
+        hi = (h[k] > hi) ? h[k] : hi;
+    }
+
+    return i;
+}
+
+size_t kernel_histogram_avx2(
+    const double * values, size_t count, double min, double max, double scale, double last, qdb_uint_t * counts)
+{
+    const __m256d vmin = _mm256_set1_pd(min);
+    const __m256d vmax = _mm256_set1_pd(max);
+    const __m256d vscale = _mm256_set1_pd(scale);
+    const __m256d vlast = _mm256_set1_pd(last);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d v = _mm256_loadu_pd(values + i);
+        const __m256d in = _mm256_and_pd(_mm256_cmp_pd(v, vmin, _CMP_GE_OQ), _mm256_cmp_pd(v, vmax, _CMP_LE_OQ));
+        const int mask = _mm256_movemask_pd(in);
+        if (!mask) continue;
+
+        const __m256d b = _mm256_min_pd(_mm256_mul_pd(_mm256_sub_pd(v, vmin), vscale), vlast);
+
+        int32_t idx[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(idx), _mm256_cvttpd_epi32(b));
+
+        for (int k = 0; k < 4; ++k)
+        {
+            if (mask & (1 << k)) ++counts[idx[k]];
+        }
+    }
+
+    return i;
+}
+
+} // namespace detail
+
+} // namespace quasardb
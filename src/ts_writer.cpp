@@ -0,0 +1,294 @@
+#include "ts_writer.hpp"
+#include "entry.hpp"
+#include "error.hpp"
+#include <vector>
+
+namespace quasardb
+{
+
+v8::Persistent<v8::Function> ColumnWriter::constructor;
+
+ColumnWriter::ColumnWriter(
+    cluster_data_ptr cd, const std::string & ts, const std::string & column, qdb_ts_column_type_t type)
+    : _type(type)
+    , _pending(false)
+    , _request(cd, [type](qdb_request * qdb_req) { ColumnWriter::execute(qdb_req, type); }, column)
+{
+    _request.input.content.str = ts;
+    _work.data = this;
+}
+
+void ColumnWriter::Init(v8::Local<v8::Object> exports)
+{
+    v8::Isolate * isolate = exports->GetIsolate();
+
+    // Prepare constructor template
+    v8::Local<v8::FunctionTemplate> tpl = v8::FunctionTemplate::New(isolate, New);
+    tpl->SetClassName(v8::String::NewFromUtf8(isolate, "ColumnWriter", v8::NewStringType::kNormal).ToLocalChecked());
+    tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+    {
+        // inserts are accounted as ColumnWriter.insert in the statistics of the cluster
+        op_stats::class_scope scope("ColumnWriter");
+        detail::SetOperation(tpl, "insert", ColumnWriter::insert);
+    }
+
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Signature> s = v8::Signature::New(isolate, tpl);
+
+    auto proto = tpl->PrototypeTemplate();
+
+    proto->SetAccessorProperty(
+        v8::String::NewFromUtf8(isolate, "timeseries", v8::NewStringType::kNormal).ToLocalChecked(),
+        v8::FunctionTemplate::New(isolate, ColumnWriter::getTsAlias, v8::Local<v8::Value>(), s),
+        v8::Local<v8::FunctionTemplate>(), v8::ReadOnly);
+    proto->SetAccessorProperty(v8::String::NewFromUtf8(isolate, "column", v8::NewStringType::kNormal).ToLocalChecked(),
+        v8::FunctionTemplate::New(isolate, ColumnWriter::getColumnAlias, v8::Local<v8::Value>(), s),
+        v8::Local<v8::FunctionTemplate>(), v8::ReadOnly);
+    proto->SetAccessorProperty(
+        v8::String::NewFromUtf8(isolate, "pending", v8::NewStringType::kNormal).ToLocalChecked(),
+        v8::FunctionTemplate::New(isolate, ColumnWriter::getPending, v8::Local<v8::Value>(), s),
+        v8::Local<v8::FunctionTemplate>(), v8::ReadOnly);
+
+    auto maybe_function = tpl->GetFunction(isolate->GetCurrentContext());
+    if (maybe_function.IsEmpty()) return;
+
+    constructor.Reset(isolate, maybe_function.ToLocalChecked());
+    exports->Set(isolate->GetCurrentContext(),
+        v8::String::NewFromUtf8(isolate, "ColumnWriter", v8::NewStringType::kNormal).ToLocalChecked(),
+        maybe_function.ToLocalChecked());
+}
+
+v8::Local<v8::Object> ColumnWriter::MakeWriter(v8::Isolate * isolate,
+    cluster_data_ptr cd,
+    const std::string & ts,
+    const std::string & column,
+    qdb_ts_column_type_t type)
+{
+    static const int argc = 1;
+
+    // the native object is handed over to the constructor, writers cannot be built from JS
+    auto writer = new ColumnWriter(cd, ts, column, type);
+    v8::Local<v8::Value> argv[argc] = {v8::External::New(isolate, writer)};
+
+    v8::Local<v8::Function> cons = v8::Local<v8::Function>::New(isolate, constructor);
+    assert(!cons.IsEmpty() && "Verify that Object::Init has been called in qdb_api.cpp:InitAll()");
+
+    return cons->NewInstance(isolate->GetCurrentContext(), argc, argv).ToLocalChecked();
+}
+
+void ColumnWriter::New(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    MethodMan call(args);
+
+    if (!args.IsConstructCall() || (args.Length() != 1) || !args[0]->IsExternal())
+    {
+        call.throwException("Use Column.writer() to create a writer");
+        return;
+    }
+
+    auto writer = static_cast<ColumnWriter *>(args[0].As<v8::External>()->Value());
+    writer->Wrap(args.This());
+    args.GetReturnValue().Set(args.This());
+}
+
+void ColumnWriter::insert(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    MethodMan call(args);
+
+    ColumnWriter * w = call.nativeHolder<ColumnWriter>();
+    assert(w);
+
+    if (w->_pending)
+    {
+        call.throwException("An insert is already in progress on this writer");
+        return;
+    }
+
+    w->_request.start_timing(call);
+
+    ArgsEater eater(call);
+    auto & content = w->_request.input.content;
+
+    switch (w->_type)
+    {
+    case qdb_ts_column_blob:
+        eater.eatAndConvertBlobPointsArray(content.blob_points);
+        break;
+    case qdb_ts_column_string:
+        eater.eatAndConvertStringPointsArray(content.string_points);
+        break;
+    case qdb_ts_column_double:
+        eater.eatAndConvertDoublePointsArray(content.double_points);
+        break;
+    case qdb_ts_column_int64:
+        eater.eatAndConvertInt64PointsArray(content.int64_points);
+        break;
+    case qdb_ts_column_timestamp:
+        eater.eatAndConvertTimestampPointsArray(content.timestamp_points);
+        break;
+    default:
+        // skip the points, the request fails with an invalid argument error
+        eater.eatArray();
+        break;
+    }
+
+    auto callback = eater.eatCallback();
+    if (!callback.second)
+    {
+        call.throwException("callback expected");
+        return;
+    }
+
+    w->_request.arguments_converted(call);
+
+    w->_request.callback.Reset(args.GetIsolate(), callback.first);
+    w->_request.pin(args.GetIsolate(), eater.pinned());
+    w->_request.output.error = qdb_e_uninitialized;
+    w->_request.start_async(args.GetIsolate());
+    w->_pending = true;
+
+    // keep the JS object, and thus the request, alive until the insert completes
+    w->Ref();
+
+    uv_queue_work(uv_default_loop(), &w->_work, ColumnWriter::executeWork, ColumnWriter::processInsertResult);
+
+    call.setUndefinedReturnValue();
+}
+
+namespace detail
+{
+
+template <typename Point, typename Insert>
+static qdb_error_t writer_insert(qdb_request * qdb_req, const std::vector<Point> & points, Insert insert)
+{
+    // same as the column inserts, empty or invalid points are rejected before reaching the C API
+    if (points.empty()) return qdb_e_invalid_argument;
+
+    return insert(qdb_req->handle(), qdb_req->input.content.str.c_str(), qdb_req->input.alias.c_str(),
+        points.data(), points.size());
+}
+
+} // namespace detail
+
+void ColumnWriter::execute(qdb_request * qdb_req, qdb_ts_column_type_t type)
+{
+    const auto & content = qdb_req->input.content;
+
+    switch (type)
+    {
+    case qdb_ts_column_blob:
+        qdb_req->output.error = detail::writer_insert(qdb_req, content.blob_points, qdb_ts_blob_insert);
+        break;
+    case qdb_ts_column_string:
+        qdb_req->output.error = detail::writer_insert(qdb_req, content.string_points, qdb_ts_string_insert);
+        break;
+    case qdb_ts_column_double:
+        qdb_req->output.error = detail::writer_insert(qdb_req, content.double_points, qdb_ts_double_insert);
+        break;
+    case qdb_ts_column_int64:
+        qdb_req->output.error = detail::writer_insert(qdb_req, content.int64_points, qdb_ts_int64_insert);
+        break;
+    case qdb_ts_column_timestamp:
+        qdb_req->output.error = detail::writer_insert(qdb_req, content.timestamp_points, qdb_ts_timestamp_insert);
+        break;
+    default:
+        qdb_req->output.error = qdb_e_invalid_argument;
+        break;
+    }
+}
+
+void ColumnWriter::executeWork(uv_work_t * req)
+{
+    static_cast<ColumnWriter *>(req->data)->_request.execute();
+}
+
+void ColumnWriter::processInsertResult(uv_work_t * req, int status)
+{
+    v8::Isolate * isolate = v8::Isolate::GetCurrent();
+    v8::HandleScope scope(isolate);
+
+    ColumnWriter * w = static_cast<ColumnWriter *>(req->data);
+    assert(w);
+
+    qdb_request & qdb_req = w->_request;
+
+    // same as Entry::processResult, the callback runs in the async context of the insert
+    node::CallbackScope callback_scope(isolate, qdb_req.async_resource(isolate), qdb_req.async_context());
+
+    v8::TryCatch try_catch(isolate);
+
+    const bool timed = qdb_req.timed();
+    const auto converting = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    v8::Local<v8::Value> error_code = v8::Null(isolate);
+    if (status < 0)
+    {
+        error_code = Error::MakeError(isolate, qdb_e_internal_local);
+    }
+    else if ((qdb_req.output.error != qdb_e_ok) && (qdb_req.output.error != qdb_e_ok_created))
+    {
+        error_code = Error::MakeError(isolate, qdb_req.output.error);
+    }
+
+    auto callback = v8::Local<v8::Function>::New(isolate, qdb_req.callback);
+    qdb_req.callback.Reset();
+    qdb_req.pinned.Reset();
+
+    // the callback may issue the next insert right away
+    w->_pending = false;
+
+    static const unsigned int argc = 1;
+    v8::Local<v8::Value> argv[argc] = {error_code};
+    if (timed) qdb_req.finish_timing(isolate, converting, status, argv, argc);
+    qdb_req.publish_end(isolate, error_code);
+
+    callback->Call(isolate->GetCurrentContext(), isolate->GetCurrentContext()->Global(), argc, argv);
+
+    w->Unref();
+
+    if (try_catch.HasCaught())
+    {
+        node::FatalException(isolate, try_catch);
+    }
+}
+
+void ColumnWriter::getTsAlias(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    MethodMan call(args);
+
+    ColumnWriter * w = call.nativeHolder<ColumnWriter>();
+    assert(w);
+
+    v8::Isolate * isolate = args.GetIsolate();
+    const auto & ts = w->_request.input.content.str;
+    args.GetReturnValue().Set(
+        v8::String::NewFromUtf8(isolate, ts.c_str(), v8::NewStringType::kNormal, static_cast<int>(ts.size()))
+            .ToLocalChecked());
+}
+
+void ColumnWriter::getColumnAlias(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    MethodMan call(args);
+
+    ColumnWriter * w = call.nativeHolder<ColumnWriter>();
+    assert(w);
+
+    v8::Isolate * isolate = args.GetIsolate();
+    const auto & column = w->_request.input.alias;
+    args.GetReturnValue().Set(
+        v8::String::NewFromUtf8(isolate, column.c_str(), v8::NewStringType::kNormal, static_cast<int>(column.size()))
+            .ToLocalChecked());
+}
+
+void ColumnWriter::getPending(const v8::FunctionCallbackInfo<v8::Value> & args)
+{
+    MethodMan call(args);
+
+    ColumnWriter * w = call.nativeHolder<ColumnWriter>();
+    assert(w);
+
+    args.GetReturnValue().Set(v8::Boolean::New(args.GetIsolate(), w->_pending));
+}
+
+} // namespace quasardb
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "cluster_data.hpp"
+#include "utilities.hpp"
+#include <qdb/ts.h>
+#include <node.h>
+#include <node_object_wrap.h>
+#include <uv.h>
+#include <string>
+
+namespace quasardb
+{
+
+// A writer is pinned to a single column. The time series and column aliases are resolved once, and the same
+// request, work item and point buffers are reused by every insert, so a hot loop of small inserts does not allocate
+// once the buffers have grown to the batch size.
+//
+// Only one insert can be in flight at a time, the next one is to be issued from the callback of the previous one.
+class ColumnWriter : public node::ObjectWrap
+{
+    ColumnWriter(cluster_data_ptr cd, const std::string & ts, const std::string & column, qdb_ts_column_type_t type);
+
+public:
+    virtual ~ColumnWriter(void)
+    {
+    }
+
+public:
+    static void Init(v8::Local<v8::Object> exports);
+
+    static v8::Local<v8::Object> MakeWriter(v8::Isolate * isolate,
+        cluster_data_ptr cd,
+        const std::string & ts,
+        const std::string & column,
+        qdb_ts_column_type_t type);
+
+private:
+    static void New(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+    // :desc: Inserts points into the column the writer is bound to.
+    // :args: points (Array) - Array of points matching the column type.
+    // callback(err) (function) - A callback or anonymous function with error parameter.
+    static void insert(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+    static void getTsAlias(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void getColumnAlias(const v8::FunctionCallbackInfo<v8::Value> & args);
+    static void getPending(const v8::FunctionCallbackInfo<v8::Value> & args);
+
+    static void execute(qdb_request * qdb_req, qdb_ts_column_type_t type);
+
+    static void executeWork(uv_work_t * req);
+    static void processInsertResult(uv_work_t * req, int status);
+
+private:
+    static v8::Persistent<v8::Function> constructor;
+
+    qdb_ts_column_type_t _type;
+    bool _pending;
+
+    // input.alias holds the column, input.content.str the time series, as for Column requests
+    qdb_request _request;
+    uv_work_t _work;
+};
+
+} // namespace quasardb
@@ -1,4 +1,11 @@
 #include "utilities.hpp"
+#include "diagnostics.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 
 namespace quasardb
 {
@@ -28,8 +35,177 @@ inline void release_node_buffer(char * data, void * hint)
 
 } // namespace detail
 
+namespace
+{
+
+uint64_t elapsed_micros(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+    return (micros > 0) ? static_cast<uint64_t>(micros) : 0u;
+}
+
+} // namespace
+
+void qdb_request::execute()
+{
+    if ((output.error != qdb_e_uninitialized) || !_execute) return;
+
+    if (!_timing.counters)
+    {
+        // the watchdog only times the JS thread
+        _execute(this);
+        return;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    _timing.counters->queue.record(elapsed_micros(_timing.queued, started));
+
+    _execute(this);
+
+    _timing.counters->execute.record(elapsed_micros(started, std::chrono::steady_clock::now()));
+}
+
+void qdb_request::start_timing(const MethodMan & call)
+{
+    // a reused request, see ColumnWriter, is timed again from scratch
+    _timing.stats.reset();
+    _timing.counters = nullptr;
+    _timing.watchdog.reset();
+
+    v8::Local<v8::Value> operation = call.args().Data();
+    if (!operation->IsUint32()) return;
+
+    _timing.operation = operation.As<v8::Uint32>()->Value();
+    if (!_cluster_data) return;
+
+    const auto & stats = _cluster_data->get_op_stats();
+    const auto & watchdog = _cluster_data->get_conversion_watchdog();
+    if (!stats && !watchdog) return;
+
+    _timing.watchdog = watchdog;
+    if (stats)
+    {
+        _timing.stats = stats;
+        _timing.counters = &stats->counters(_timing.operation);
+    }
+
+    _timing.queued = std::chrono::steady_clock::now();
+}
+
+void qdb_request::arguments_converted(const MethodMan & call)
+{
+    if (!timed()) return;
+
+    const auto converted = std::chrono::steady_clock::now();
+    const uint64_t micros = elapsed_micros(_timing.queued, converted);
+    _timing.queued = converted;
+
+    if (_timing.counters)
+    {
+        _timing.counters->bytes_in.fetch_add(
+            input.content.buffer.size + input.content.comparand.size, std::memory_order_relaxed);
+    }
+
+    if (_timing.watchdog && _timing.watchdog->exceeds(micros))
+    {
+        _timing.watchdog->report(call.args().GetIsolate(), "arguments", _timing.operation, input.alias,
+            conversion_watchdog::element_count(call.args()), micros);
+    }
+}
+
+void qdb_request::finish_timing(v8::Isolate * isolate,
+    std::chrono::steady_clock::time_point converting,
+    int status,
+    const v8::Local<v8::Value> * argv,
+    size_t argc)
+{
+    const uint64_t micros = elapsed_micros(converting, std::chrono::steady_clock::now());
+
+    if (_timing.counters)
+    {
+        _timing.counters->convert.record(micros);
+        _timing.counters->calls.fetch_add(1, std::memory_order_relaxed);
+
+        if ((status < 0) || ((output.error != qdb_e_ok) && (output.error != qdb_e_ok_created)))
+        {
+            _timing.counters->errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (_timing.watchdog && _timing.watchdog->exceeds(micros))
+    {
+        _timing.watchdog->report(
+            isolate, "result", _timing.operation, input.alias, conversion_watchdog::element_count(argv, argc), micros);
+    }
+}
+
+void qdb_request::start_async(v8::Isolate * isolate)
+{
+    // a reused request, see ColumnWriter, is a new resource for every call, the previous one is over
+    if (!_async.resource.IsEmpty()) node::EmitAsyncDestroy(isolate, _async.context);
+    _async.message.Reset();
+
+    v8::Local<v8::Object> resource = v8::Object::New(isolate);
+    _async.resource.Reset(isolate, resource);
+    _async.context = node::EmitAsyncInit(isolate, resource, "QDB_REQUEST");
+
+    if (!has_subscribers(isolate, diagnostics_channel::request_start) &&
+        !has_subscribers(isolate, diagnostics_channel::request_end))
+    {
+        return;
+    }
+
+    auto context = isolate->GetCurrentContext();
+    const std::string & operation = op_stats::operation_name(_timing.operation);
+
+    v8::Local<v8::Object> message = v8::Object::New(isolate);
+    message
+        ->Set(context, property_key(isolate, key::operation),
+            v8::String::NewFromUtf8(
+                isolate, operation.c_str(), v8::NewStringType::kNormal, static_cast<int>(operation.size()))
+                .ToLocalChecked())
+        .FromJust();
+    message
+        ->Set(context, property_key(isolate, key::alias),
+            v8::String::NewFromUtf8(
+                isolate, input.alias.c_str(), v8::NewStringType::kNormal, static_cast<int>(input.alias.size()))
+                .ToLocalChecked())
+        .FromJust();
+
+    _async.message.Reset(isolate, message);
+    _async.started = std::chrono::steady_clock::now();
+
+    publish(isolate, diagnostics_channel::request_start, message);
+}
+
+void qdb_request::publish_end(v8::Isolate * isolate, v8::Local<v8::Value> error)
+{
+    if (_async.message.IsEmpty()) return;
+
+    auto context = isolate->GetCurrentContext();
+    const uint64_t micros = elapsed_micros(_async.started, std::chrono::steady_clock::now());
+
+    v8::Local<v8::Object> message = v8::Local<v8::Object>::New(isolate, _async.message);
+    message->Set(context, property_key(isolate, key::error), error).FromJust();
+    message
+        ->Set(context, property_key(isolate, key::duration),
+            v8::Number::New(isolate, static_cast<double>(micros) / 1000.0))
+        .FromJust();
+
+    publish(isolate, diagnostics_channel::request_end, message);
+}
+
 v8::MaybeLocal<v8::Object> qdb_request::make_node_buffer(v8::Isolate * isolate, const void * buf, size_t length)
 {
+    if (_timing.counters) _timing.counters->bytes_out.fetch_add(length, std::memory_order_relaxed);
+
+    if (output.buffer_malloced && (buf == output.content.buffer.begin))
+    {
+        // node frees it with free() once the Buffer is collected
+        if (!buf || !length) return node::Buffer::New(isolate, static_cast<size_t>(0u));
+        return node::Buffer::New(isolate, static_cast<char *>(const_cast<void *>(buf)), length);
+    }
+
     qdb_handle_t h = handle();
 
     if (!h || !buf || !length)
@@ -41,6 +217,53 @@ v8::MaybeLocal<v8::Object> qdb_request::make_node_buffer(v8::Isolate * isolate,
         isolate, static_cast<char *>(const_cast<void *>(buf)), length, detail::release_node_buffer, h);
 }
 
+void qdb_request::pack_aliases()
+{
+    if (output.error != qdb_e_ok) return;
+
+    const char ** entries = reinterpret_cast<const char **>(const_cast<void *>(output.content.buffer.begin));
+    const size_t count = output.content.buffer.size;
+
+    auto & offsets = output.packed_offsets;
+    offsets.resize(count + 1);
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        offsets[i] = static_cast<uint32_t>(total);
+        total += std::strlen(entries[i]);
+
+        if (total > std::numeric_limits<uint32_t>::max()) break;
+    }
+
+    void * packed = nullptr;
+    if (total > std::numeric_limits<uint32_t>::max())
+    {
+        output.error = qdb_e_out_of_bounds;
+    }
+    else if (total && !(packed = std::malloc(total)))
+    {
+        output.error = qdb_e_no_memory_local;
+    }
+    else
+    {
+        offsets[count] = static_cast<uint32_t>(total);
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(static_cast<char *>(packed) + offsets[i], entries[i], offsets[i + 1] - offsets[i]);
+        }
+    }
+
+    // safe to call even on null/invalid buffers
+    qdb_release(handle(), entries);
+
+    output.content.buffer.begin = packed;
+    output.content.buffer.size = packed ? total : 0;
+    output.buffer_malloced = true;
+
+    if (output.error != qdb_e_ok) offsets.clear();
+}
+
 qdb_time_t ArgsEater::eatAndConvertDate()
 {
     // we get a Date object a convert that to qdb_time_t
@@ -74,6 +297,58 @@ qdb_time_t ArgsEater::eatAndConvertDate()
     return res;
 }
 
+qdb_time_t ArgsEater::eatAndConvertDeadline()
+{
+    const auto date = _method.checkedArgDate(_pos);
+    if (date.second)
+    {
+        ++_pos;
+        return static_cast<qdb_time_t>(date.first->ValueOf());
+    }
+
+    const auto number = _method.checkedArgNumber(_pos);
+    if (!number.second || !std::isfinite(number.first) || (number.first < 0.0))
+    {
+        // the argument is not consumed, the caller fails to find the callback
+        return static_cast<qdb_time_t>(0);
+    }
+
+    ++_pos;
+
+    const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    return static_cast<qdb_time_t>(now.count()) + static_cast<qdb_time_t>(number.first);
+}
+
+batch_options ArgsEater::eatAndConvertBatchOptions()
+{
+    batch_options res;
+
+    const auto options = _method.checkedArgObject(_pos);
+    if (!options.second) return res;
+
+    ++_pos;
+
+    v8::Isolate * isolate = v8::Isolate::GetCurrent();
+    auto context = isolate->GetCurrentContext();
+
+    v8::Local<v8::Value> dedupe;
+    if (options.first->Get(context, property_key(isolate, key::dedupe)).ToLocal(&dedupe))
+    {
+        res.dedupe = dedupe->BooleanValue(isolate);
+    }
+
+    // invalid sizes keep the default
+    v8::Local<v8::Value> batch_size;
+    if (options.first->Get(context, property_key(isolate, key::batch_size)).ToLocal(&batch_size)
+        && batch_size->IsNumber() && (batch_size.As<v8::Number>()->Value() >= 1.0))
+    {
+        res.batch_size = static_cast<size_t>(std::min(batch_size.As<v8::Number>()->Value(), 1e9));
+    }
+
+    return res;
+}
+
 template <typename Type, typename Func>
 std::vector<Type> eatAndConvertArray(ArgsEater & eater, Func convert)
 {
@@ -118,9 +393,9 @@ std::vector<column_info> ArgsEater::eatAndConvertColumnsInfoArray()
 {
     auto isolate = v8::Isolate::GetCurrent();
 
-    auto nameProp = v8::String::NewFromUtf8(isolate, "name", v8::NewStringType::kNormal).ToLocalChecked();
-    auto typeProp = v8::String::NewFromUtf8(isolate, "type", v8::NewStringType::kNormal).ToLocalChecked();
-    auto symtableProp = v8::String::NewFromUtf8(isolate, "symtable", v8::NewStringType::kNormal).ToLocalChecked();
+    auto nameProp = property_key(isolate, key::name);
+    auto typeProp = property_key(isolate, key::type);
+    auto symtableProp = property_key(isolate, key::symtable);
 
     return eatAndConvertArray<column_info>(*this,
         [&](v8::Local<v8::Value> vi)
@@ -168,48 +443,51 @@ std::vector<column_info> ArgsEater::eatAndConvertColumnsInfoArray()
 }
 
 template <typename Type, typename Func>
-std::vector<Type> eatAndConvertPointsArray(ArgsEater & eater, Func convert)
+bool convertPointsArray(ArgsEater & eater, std::vector<Type> & res, Func convert)
 {
-    using point_vector = std::vector<Type>;
-
     auto arr = eater.eatArray();
-    if (!arr.second) return {};
+    if (!arr.second) return false;
 
     auto len = arr.first->Length();
-    point_vector res;
     res.reserve(len);
 
     auto isolate = v8::Isolate::GetCurrent();
     auto context = isolate->GetCurrentContext();
 
-    auto tsProp = v8::String::NewFromUtf8(isolate, "timestamp", v8::NewStringType::kNormal).ToLocalChecked();
-    auto valueProp = v8::String::NewFromUtf8(isolate, "value", v8::NewStringType::kNormal).ToLocalChecked();
+    auto tsProp = property_key(isolate, key::timestamp);
+    auto valueProp = property_key(isolate, key::value);
 
     for (auto i = 0u; i < len; ++i)
     {
         auto vi = arr.first->Get(context, i).ToLocalChecked();
-        if (!vi->IsObject()) return {};
+        if (!vi->IsObject()) return false;
 
         auto maybe_obj = vi->ToObject(isolate->GetCurrentContext());
-        if (maybe_obj.IsEmpty()) return {};
+        if (maybe_obj.IsEmpty()) return false;
 
         auto obj = maybe_obj.ToLocalChecked();
         auto date = obj->Get(context, tsProp).ToLocalChecked();
         auto value = obj->Get(context, valueProp).ToLocalChecked();
 
-        if (!Timestamp::InstanceOf(isolate, date)) return {};
+        // plain {timestamp, value} objects are accepted as well as points, no Timestamp needs to be allocated
+        qdb_timespec_t timestamp;
+        if (!value_to_qdb_timespec(isolate, date, timestamp)) return false;
 
-        auto maybe_timestamp = date->ToObject(context);
-        if (maybe_timestamp.IsEmpty()) return {};
-
-        auto timestamp = node::ObjectWrap::Unwrap<Timestamp>(maybe_timestamp.ToLocalChecked());
-        auto point = convert(timestamp->getTimespec(), value);
-        if (!point.second) return {};
+        auto point = convert(timestamp, value);
+        if (!point.second) return false;
 
         res.push_back(std::move(point.first));
     }
 
-    return res;
+    return true;
+}
+
+template <typename Type, typename Func>
+void eatAndConvertPointsArray(ArgsEater & eater, std::vector<Type> & res, Func convert)
+{
+    // keep the capacity, the vector may belong to a reused request
+    res.clear();
+    if (!convertPointsArray(eater, res, convert)) res.clear();
 }
 
 static bool InstanceOfBuffer(v8::Isolate * isolate, v8::Local<v8::Value> val)
@@ -225,9 +503,9 @@ static bool InstanceOfBuffer(v8::Isolate * isolate, v8::Local<v8::Value> val)
     return node::Buffer::HasInstance(obj);
 }
 
-std::vector<qdb_ts_blob_point> ArgsEater::eatAndConvertBlobPointsArray()
+void ArgsEater::eatAndConvertBlobPointsArray(std::vector<qdb_ts_blob_point> & points)
 {
-    return eatAndConvertPointsArray<qdb_ts_blob_point>(*this,
+    eatAndConvertPointsArray(*this, points,
         [&](qdb_timespec_t ts, v8::Local<v8::Value> value)
         {
             qdb_ts_blob_point p;
@@ -238,13 +516,14 @@ std::vector<qdb_ts_blob_point> ArgsEater::eatAndConvertBlobPointsArray()
             p.timestamp = ts;
             p.content = node::Buffer::Data(value);
             p.content_length = node::Buffer::Length(value);
+            _pinned.push_back(value);
             return std::make_pair(p, true);
         });
 }
 
-std::vector<qdb_ts_string_point> ArgsEater::eatAndConvertStringPointsArray()
+void ArgsEater::eatAndConvertStringPointsArray(std::vector<qdb_ts_string_point> & points)
 {
-    return eatAndConvertPointsArray<qdb_ts_string_point>(*this,
+    eatAndConvertPointsArray(*this, points,
         [&](qdb_timespec_t ts, v8::Local<v8::Value> value)
         {
             qdb_ts_string_point p;
@@ -255,13 +534,14 @@ std::vector<qdb_ts_string_point> ArgsEater::eatAndConvertStringPointsArray()
             p.timestamp = ts;
             p.content = node::Buffer::Data(value);
             p.content_length = node::Buffer::Length(value);
+            _pinned.push_back(value);
             return std::make_pair(p, true);
         });
 }
 
-std::vector<qdb_ts_double_point> ArgsEater::eatAndConvertDoublePointsArray()
+void ArgsEater::eatAndConvertDoublePointsArray(std::vector<qdb_ts_double_point> & points)
 {
-    return eatAndConvertPointsArray<qdb_ts_double_point>(*this,
+    eatAndConvertPointsArray(*this, points,
         [](qdb_timespec_t ts, v8::Local<v8::Value> value)
         {
             qdb_ts_double_point p;
@@ -283,9 +563,9 @@ std::vector<qdb_ts_double_point> ArgsEater::eatAndConvertDoublePointsArray()
         });
 }
 
-std::vector<qdb_ts_int64_point> ArgsEater::eatAndConvertInt64PointsArray()
+void ArgsEater::eatAndConvertInt64PointsArray(std::vector<qdb_ts_int64_point> & points)
 {
-    return eatAndConvertPointsArray<qdb_ts_int64_point>(*this,
+    eatAndConvertPointsArray(*this, points,
         [](qdb_timespec_t ts, v8::Local<v8::Value> value)
         {
             qdb_ts_int64_point p;
@@ -307,32 +587,52 @@ std::vector<qdb_ts_int64_point> ArgsEater::eatAndConvertInt64PointsArray()
         });
 }
 
-std::vector<qdb_ts_timestamp_point> ArgsEater::eatAndConvertTimestampPointsArray()
+void ArgsEater::eatAndConvertTimestampPointsArray(std::vector<qdb_ts_timestamp_point> & points)
 {
-    return eatAndConvertPointsArray<qdb_ts_timestamp_point>(*this,
+    eatAndConvertPointsArray(*this, points,
         [](qdb_timespec_t ts, v8::Local<v8::Value> value)
         {
             qdb_ts_timestamp_point p;
             auto isolate = v8::Isolate::GetCurrent();
-            auto context = isolate->GetCurrentContext();
 
-            if (!Timestamp::InstanceOf(isolate, value)) return std::make_pair(p, false);
-
-            auto maybe_timestamp_value = value->ToObject(context);
-            if (maybe_timestamp_value.IsEmpty())
-            {
-                return std::make_pair(p, false);
-            }
-
-            auto timestamp_value = node::ObjectWrap::Unwrap<Timestamp>(maybe_timestamp_value.ToLocalChecked());
+            if (!value_to_qdb_timespec(isolate, value, p.value)) return std::make_pair(p, false);
 
             p.timestamp = ts;
-            p.value = timestamp_value->getTimespec();
-
             return std::make_pair(p, true);
         });
 }
 
+static typed_array_view makeTypedArrayView(v8::Local<v8::Value> value)
+{
+    auto array = value.As<v8::TypedArray>();
+
+    typed_array_view view;
+    view.store = array->Buffer()->GetBackingStore();
+    view.offset = array->ByteOffset();
+    view.length = array->Length();
+    return view;
+}
+
+columnar_points ArgsEater::eatAndConvertColumnarPoints(bool (v8::Value::*is_values)() const)
+{
+    columnar_points res;
+
+    auto obj = eatObject();
+    if (!obj.second) return res;
+
+    auto isolate = v8::Isolate::GetCurrent();
+    auto context = isolate->GetCurrentContext();
+
+    auto timestamps = obj.first->Get(context, property_key(isolate, key::timestamps)).ToLocalChecked();
+    auto values = obj.first->Get(context, property_key(isolate, key::values)).ToLocalChecked();
+    if (!timestamps->IsBigInt64Array() || !((*values)->*is_values)()) return res;
+
+    // lengths are checked with the conversion, on the worker thread
+    res.timestamps = makeTypedArrayView(timestamps);
+    res.values = makeTypedArrayView(values);
+    return res;
+}
+
 std::vector<qdb_ts_range_t> ArgsEater::eatAndConvertRangeArray()
 {
     auto isolate = v8::Isolate::GetCurrent();
@@ -352,16 +652,129 @@ std::vector<qdb_ts_range_t> ArgsEater::eatAndConvertRangeArray()
         });
 }
 
-std::string ArgsEater::eatAndConvertTsAlias()
+downsample_options ArgsEater::eatAndConvertDownsampleOptions()
+{
+    downsample_options res;
+
+    auto obj = eatObject();
+    if (!obj.second) return res;
+
+    auto isolate = v8::Isolate::GetCurrent();
+    auto context = isolate->GetCurrentContext();
+
+    auto methodProp = property_key(isolate, key::method);
+    auto bucketsProp = property_key(isolate, key::buckets);
+
+    auto method = obj.first->Get(context, methodProp).ToLocalChecked();
+    auto buckets = obj.first->Get(context, bucketsProp).ToLocalChecked();
+
+    if (!method->IsString() || !buckets->IsNumber()) return res;
+
+    // NaN, infinities and fractions are rejected rather than truncated, as for the histogram buckets
+    const double count = buckets->NumberValue(context).FromMaybe(0.0);
+    if (!(count >= 0.0) || (count > static_cast<double>(downsample_options::max_buckets)) || (std::floor(count) != count))
+    {
+        return res;
+    }
+
+    res.method = downsample_method_from_string(convertString(method->ToString(context).ToLocalChecked()));
+    res.buckets = static_cast<size_t>(count);
+
+    return res;
+}
+
+std::vector<kernel_spec> ArgsEater::eatAndConvertKernelArray()
 {
-    auto holder = _method.holder();
     auto isolate = v8::Isolate::GetCurrent();
-    auto tsProp = v8::String::NewFromUtf8(isolate, "timeseries", v8::NewStringType::kNormal).ToLocalChecked();
+    auto context = isolate->GetCurrentContext();
+
+    auto opProp = property_key(isolate, key::op);
+    auto pProp = property_key(isolate, key::p);
+    auto alphaProp = property_key(isolate, key::alpha);
+    auto bucketsProp = property_key(isolate, key::buckets);
+    auto minProp = property_key(isolate, key::minimum);
+    auto maxProp = property_key(isolate, key::maximum);
+
+    return eatAndConvertArray<kernel_spec>(*this,
+        [&](v8::Local<v8::Value> vi)
+        {
+            if (!vi->IsObject()) return std::make_pair(kernel_spec{}, false);
+
+            auto maybe_obj = vi->ToObject(context);
+            if (maybe_obj.IsEmpty()) return std::make_pair(kernel_spec{}, false);
 
-    auto ts = holder->Get(isolate->GetCurrentContext(), tsProp).ToLocalChecked();
-    if (!ts->IsString()) return std::string();
+            auto obj = maybe_obj.ToLocalChecked();
+            auto op = obj->Get(context, opProp).ToLocalChecked();
+            if (!op->IsString()) return std::make_pair(kernel_spec{}, false);
+
+            kernel_spec spec;
+            spec.op = kernel_op_from_string(convertString(op->ToString(context).ToLocalChecked()));
+
+            auto number = [&](v8::Local<v8::String> prop, double & out)
+            {
+                auto v = obj->Get(context, prop).ToLocalChecked();
+                if (!v->IsNumber()) return false;
+
+                out = v->NumberValue(context).FromMaybe(0.0);
+                return true;
+            };
+
+            switch (spec.op)
+            {
+            case kernel_op::percentile:
+                if (!number(pProp, spec.param)) return std::make_pair(kernel_spec{}, false);
+                break;
+
+            case kernel_op::ewma:
+                if (!number(alphaProp, spec.param)) return std::make_pair(kernel_spec{}, false);
+                break;
+
+            case kernel_op::histogram:
+            {
+                // checked before the conversion, NaN, infinite or huge counts do not fit a size_t
+                double buckets = 0.0;
+                if (!number(bucketsProp, buckets) || !(buckets >= 1.0)
+                    || (buckets > static_cast<double>(kernel_spec::max_buckets)) || (std::floor(buckets) != buckets))
+                {
+                    return std::make_pair(kernel_spec{}, false);
+                }
+                spec.buckets = static_cast<size_t>(buckets);
+
+                // bounds are optional, but must be given together
+                const bool has_min = number(minProp, spec.min);
+                const bool has_max = number(maxProp, spec.max);
+                if (has_min != has_max) return std::make_pair(kernel_spec{}, false);
+                spec.has_bounds = has_min;
+                break;
+            }
+
+            default:
+                break;
+            }
+
+            return std::make_pair(spec, spec.valid());
+        });
+}
+
+byte_range ArgsEater::eatAndConvertByteRange()
+{
+    byte_range res;
 
-    return convertString(ts->ToString(isolate->GetCurrentContext()).ToLocalChecked());
+    auto offset = eatNumber();
+    if (!offset.second) return res;
+
+    auto length = eatNumber();
+    if (!length.second) return res;
+
+    // negative, fractional or unsafe integers leave the range invalid
+    auto valid = [](double v) { return (v >= 0.0) && (v <= 9007199254740991.0) && (std::floor(v) == v); };
+    if (valid(offset.first) && valid(length.first))
+    {
+        res.offset = static_cast<qdb_int_t>(offset.first);
+        res.length = static_cast<qdb_int_t>(length.first);
+    }
+
+    return res;
 }
 
 qdb_request::slice ArgsEater::eatAndConvertBuffer()
@@ -374,6 +787,7 @@ qdb_request::slice ArgsEater::eatAndConvertBuffer()
     {
         res.begin = node::Buffer::Data(buf.first);
         res.size = node::Buffer::Length(buf.first);
+        _pinned.push_back(buf.first);
     }
     else
     {
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "blob_codec.hpp"
 #include "cluster_data.hpp"
+#include "keys.hpp"
 #include "time.hpp"
 #include "ts_aggregation.hpp"
+#include "ts_downsample.hpp"
+#include "ts_kernels.hpp"
 #include "ts_range.hpp"
 #include <qdb/batch.h>
 #include <qdb/client.h>
@@ -12,7 +16,12 @@
 #include <node.h>
 #include <node_buffer.h>
 #include <array>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -66,6 +75,16 @@ struct NewObject<Timestamp>
     }
 };
 
+// Allocates a typed array of `length` elements and exposes its storage, so that it can be filled without going
+// through V8 for each element.
+template <typename TypedArray, typename Element>
+v8::Local<TypedArray> NewTypedArray(v8::Isolate * isolate, size_t length, Element *& data)
+{
+    auto buffer = v8::ArrayBuffer::New(isolate, length * sizeof(Element));
+    data = static_cast<Element *>(buffer->GetBackingStore()->Data());
+    return TypedArray::New(buffer, 0, length);
+}
+
 } // namespace detail
 
 // POD for storing info about columns from js calls
@@ -76,6 +95,70 @@ struct column_info
     std::string symtable;
 };
 
+// Part of a blob, in bytes. Negative values are invalid.
+struct byte_range
+{
+    byte_range()
+        : offset(-1)
+        , length(-1)
+    {
+    }
+
+    qdb_int_t offset;
+    qdb_int_t length;
+};
+
+// Options of the operations on many entries, see Batch.
+struct batch_options
+{
+    batch_options()
+        : dedupe(false)
+        , batch_size(1000)
+    {
+    }
+
+    // aliases returned by several lookups are only kept once
+    bool dedupe;
+
+    // number of aliases handed to a thread at once
+    size_t batch_size;
+};
+
+// Memory of a typed array, captured on the JS thread. Holding the backing store keeps the memory alive until the
+// request completes, and unlike the typed array it can be read from the worker thread.
+struct typed_array_view
+{
+    typed_array_view()
+        : offset(0)
+        , length(0)
+    {
+    }
+
+    std::shared_ptr<v8::BackingStore> store;
+
+    // in bytes
+    size_t offset;
+
+    // in elements
+    size_t length;
+
+    template <typename T>
+    const T * data() const
+    {
+        return reinterpret_cast<const T *>(static_cast<const char *>(store->Data()) + offset);
+    }
+};
+
+// Points given as one typed array per member, converted to points on the worker thread
+struct columnar_points
+{
+    // nanoseconds since epoch
+    typed_array_view timestamps;
+    typed_array_view values;
+};
+
+struct MethodMan;
+
 struct qdb_request
 {
     struct slice
@@ -97,16 +180,26 @@ struct qdb_request
         struct query_content
         {
             query_content()
-                : value(0)
+                : codec(blob_codec::none)
+                , value(0)
             {
                 buffer.begin = nullptr;
                 buffer.size = 0;
+                comparand.begin = nullptr;
+                comparand.size = 0;
             }
 
             std::string str;
             std::vector<std::string> strs;
             slice buffer;
+            slice comparand;
+
+            // blob contents are encoded with the codec on the worker thread, into encoded
+            blob_codec codec;
+            std::vector<unsigned char> encoded;
             qdb_int_t value;
+            byte_range range;
+            batch_options batch;
 
             // Time series
             // TODO(denisb): consider to move it all to err slice ?
@@ -117,6 +210,7 @@ struct qdb_request
             std::vector<qdb_ts_double_point> double_points;
             std::vector<qdb_ts_int64_point> int64_points;
             std::vector<qdb_ts_timestamp_point> timestamp_points;
+            columnar_points columnar;
 
             std::vector<qdb_ts_range_t> ranges;
 
@@ -125,6 +219,9 @@ struct qdb_request
             std::vector<qdb_ts_double_aggregation_t> double_aggrs;
             std::vector<qdb_ts_int64_aggregation_t> int64_aggrs;
             std::vector<qdb_ts_timestamp_aggregation_t> timestamp_aggrs;
+
+            downsample_options downsample;
+            std::vector<kernel_spec> kernels;
         };
 
         query_content content;
@@ -135,7 +232,8 @@ struct qdb_request
     struct result
     {
         result(qdb_error_t err = qdb_e_uninitialized)
-            : error(err)
+            : buffer_malloced(false)
+            , error(err)
         {
         }
 
@@ -149,14 +247,49 @@ struct qdb_request
             qdb_time_t date;
         } content;
 
+        // the operations run with qdb_run_batch, or the status of each alias of input.content.strs for the operations
+        // the batch API does not have
         struct
         {
             std::vector<qdb_operation_t> operations;
+            std::vector<qdb_error_t> statuses;
             qdb_size_t success_count;
         } batch;
 
+        // reduced series computed on the worker thread
+        std::vector<qdb_ts_double_point> double_points;
+        std::vector<kernel_result> kernels;
+
+        // aliases of many lookups run on the worker thread, the arrays returned by the C API and the aliases kept
+        struct
+        {
+            std::vector<slice> results;
+            std::vector<std::vector<const char *>> aliases;
+        } lookups;
+
+        // offsets of the aliases packed in content.buffer, one more than the number of aliases, see pack_aliases
+        std::vector<uint32_t> packed_offsets;
+
+        // page of aliases enumerated on the worker thread, see key_pager
+        struct
+        {
+            std::vector<std::string> aliases;
+            std::string token;
+        } page;
+
+        // dictionary encoded series decoded on the worker thread
+        struct
+        {
+            std::vector<int64_t> timestamps;
+            std::vector<std::string> dictionary;
+            std::vector<uint32_t> codes;
+        } columnar;
+
         qdb_query_result_t * query_result;
 
+        // content.buffer was allocated with malloc rather than by the C API, see make_node_buffer
+        bool buffer_malloced;
+
         qdb_error_t error;
     };
 
@@ -175,8 +308,13 @@ struct qdb_request
 
     ~qdb_request()
     {
+        if (!_async.resource.IsEmpty()) node::EmitAsyncDestroy(v8::Isolate::GetCurrent(), _async.context);
+
         callback.Reset();
         holder.Reset();
+        pinned.Reset();
+        _async.resource.Reset();
+        _async.message.Reset();
     }
 
 private:
@@ -189,6 +327,11 @@ public:
         return _cluster_data ? static_cast<qdb_handle_t>(_cluster_data->handle().get()) : nullptr;
     }
 
+    bool not_found_as_null() const
+    {
+        return _cluster_data && _cluster_data->not_found_as_null();
+    }
+
     void on_error(v8::Isolate * isolate, const v8::Local<v8::Object> & error_object)
     {
         if (!_cluster_data) return;
@@ -202,8 +345,26 @@ public:
         return make_node_buffer(isolate, output.content.buffer.begin, output.content.buffer.size);
     }
 
+    // To be called on the worker thread once the C API returned an array of aliases in output.content.buffer.
+    // Replaces it with the aliases concatenated in a single malloc'd buffer, their offsets in output.packed_offsets.
+    void pack_aliases();
+
+    // Keeps the given values, and thus the memory of the Buffers the input points to, alive until the request is
+    // destroyed or pinned again. Replaces whatever was pinned before.
+    void pin(v8::Isolate * isolate, std::vector<v8::Local<v8::Value>> & values)
+    {
+        if (values.empty())
+        {
+            pinned.Reset();
+            return;
+        }
+
+        pinned.Reset(isolate, v8::Array::New(isolate, values.data(), values.size()));
+    }
+
     v8::Persistent<v8::Function> callback;
     v8::Persistent<v8::Object> holder;
+    v8::Persistent<v8::Array> pinned;
 
     v8::Local<v8::Function> callbackAsLocal()
     {
@@ -215,20 +376,72 @@ public:
         return *reinterpret_cast<v8::Local<v8::Function> *>(const_cast<v8::Persistent<v8::Function> *>(&callback));
     }
 
-    void execute()
+    void execute();
+
+    // Times the request, when the cluster has statistics or the conversion watchdog enabled. From the JS thread,
+    // before the arguments of the call are converted. The operation is the data of the method called, see
+    // detail::SetOperation.
+    void start_timing(const MethodMan & call);
+
+    // Accounts the conversion of the arguments of the call, once the input is bound.
+    void arguments_converted(const MethodMan & call);
+
+    bool timed() const
     {
-        if ((output.error == qdb_e_uninitialized) && (_execute))
-        {
-            _execute(this);
-        }
+        return _timing.counters || _timing.watchdog;
+    }
+
+    // Accounts the conversion of the result to the argc values of argv, started at converting, and the outcome of the
+    // request.
+    void finish_timing(v8::Isolate * isolate,
+        std::chrono::steady_clock::time_point converting,
+        int status,
+        const v8::Local<v8::Value> * argv,
+        size_t argc);
+
+    // Makes the request an async resource, so that its callback runs in the async context of the call, and publishes
+    // its start on the diagnostics channels. From the JS thread, once the request is bound.
+    void start_async(v8::Isolate * isolate);
+
+    v8::Local<v8::Object> async_resource(v8::Isolate * isolate) const
+    {
+        return v8::Local<v8::Object>::New(isolate, _async.resource);
+    }
+
+    node::async_context async_context() const
+    {
+        return _async.context;
     }
 
+    // Publishes the end of the request with the error passed to the callback, before the callback is called.
+    void publish_end(v8::Isolate * isolate, v8::Local<v8::Value> error);
+
     query input;
     result output;
 
 private:
     std::function<void(qdb_request *)> _execute;
 
+    struct
+    {
+        // keeps the counters alive when statistics are disabled or reset while the request runs
+        op_stats_ptr stats;
+        op_counters * counters = nullptr;
+        conversion_watchdog_ptr watchdog;
+        uint32_t operation = std::numeric_limits<uint32_t>::max();
+        // when the conversion of the arguments started, then when the request was queued
+        std::chrono::steady_clock::time_point queued;
+    } _timing;
+
+    struct
+    {
+        node::async_context context{};
+        v8::Persistent<v8::Object> resource;
+        // published on the diagnostics channels, empty when there were no subscribers when the request was made
+        v8::Persistent<v8::Object> message;
+        std::chrono::steady_clock::time_point started;
+    } _async;
+
     // prevent copy
     qdb_request(const qdb_request &)
     {
@@ -463,6 +676,12 @@ public:
 
     qdb_time_t eatAndConvertDate();
 
+    // Expected either a Date or a non negative number of milliseconds from now, returns an absolute time.
+    qdb_time_t eatAndConvertDeadline();
+
+    // Optional {dedupe, batchSize} object, defaults when absent.
+    batch_options eatAndConvertBatchOptions();
+
     std::string convertString(const v8::Local<v8::String> & s)
     {
         v8::String::Utf8Value val(v8::Isolate::GetCurrent(), s);
@@ -479,19 +698,43 @@ public:
 
     std::vector<std::string> eatAndConvertStringArray();
 
+    // Expected two integers, an offset and a length in bytes.
+    byte_range eatAndConvertByteRange();
+
     // Expected array of JS objects which has two properties:
     //	name - string, column name
     //	type - integer, column type
     std::vector<column_info> eatAndConvertColumnsInfoArray();
 
-    std::vector<qdb_ts_blob_point> eatAndConvertBlobPointsArray();
-    std::vector<qdb_ts_string_point> eatAndConvertStringPointsArray();
-    std::vector<qdb_ts_double_point> eatAndConvertDoublePointsArray();
-    std::vector<qdb_ts_int64_point> eatAndConvertInt64PointsArray();
-    std::vector<qdb_ts_timestamp_point> eatAndConvertTimestampPointsArray();
+    // Expected array of point objects, converted in place so that callers can reuse the vector capacity.
+    // The vector is left empty when any of the points is invalid.
+    void eatAndConvertBlobPointsArray(std::vector<qdb_ts_blob_point> & points);
+    void eatAndConvertStringPointsArray(std::vector<qdb_ts_string_point> & points);
+    void eatAndConvertDoublePointsArray(std::vector<qdb_ts_double_point> & points);
+    void eatAndConvertInt64PointsArray(std::vector<qdb_ts_int64_point> & points);
+    void eatAndConvertTimestampPointsArray(std::vector<qdb_ts_timestamp_point> & points);
+
+    // Expected JS object which has two typed array properties:
+    //	timestamps - BigInt64Array, nanoseconds since epoch
+    //	values - typed array matching the column, checked with is_values
+    // Only the backing stores are captured, the views are left empty on incorrect input.
+    columnar_points eatAndConvertColumnarPoints(bool (v8::Value::*is_values)() const);
 
     std::vector<qdb_ts_range_t> eatAndConvertRangeArray();
 
+    // Expected JS object which has two properties:
+    //	method - string, one of 'lttb', 'minmax' or 'avg'
+    //	buckets - integer, number of buckets
+    downsample_options eatAndConvertDownsampleOptions();
+
+    // Expected array of JS objects which has the following properties:
+    //	op - string, one of 'percentile', 'ewma', 'rate' or 'histogram'
+    //	p - number, percentile rank in [0, 100]
+    //	alpha - number, ewma smoothing factor in (0, 1]
+    //	buckets - integer, histogram buckets count
+    //	min, max - number, optional histogram bounds
+    std::vector<kernel_spec> eatAndConvertKernelArray();
+
     template <typename Type>
     std::vector<Type> eatAndConvertAggrArray()
     {
@@ -536,13 +779,20 @@ public:
         return _method.holder();
     }
 
-    std::string eatAndConvertTsAlias();
-
     qdb_request::slice eatAndConvertBuffer();
 
+    // Buffers whose memory is referenced by the converted input, in the order they were eaten.
+    // To be pinned on the request so that they outlive the call.
+    std::vector<v8::Local<v8::Value>> & pinned()
+    {
+        return _pinned;
+    }
+
 private:
     const MethodMan & _method;
     int _pos;
+
+    std::vector<v8::Local<v8::Value>> _pinned;
 };
 
 class ArgsEaterBinder
@@ -585,6 +835,20 @@ public:
     qdb_request & buffer(qdb_request & req)
     {
         req.input.content.buffer = _eater.eatAndConvertBuffer();
+        req.pin(v8::Isolate::GetCurrent(), _eater.pinned());
+        return req;
+    }
+
+    qdb_request & comparand(qdb_request & req)
+    {
+        req.input.content.comparand = _eater.eatAndConvertBuffer();
+        req.pin(v8::Isolate::GetCurrent(), _eater.pinned());
+        return req;
+    }
+
+    qdb_request & byteRange(qdb_request & req)
+    {
+        req.input.content.range = _eater.eatAndConvertByteRange();
         return req;
     }
 
@@ -594,6 +858,18 @@ public:
         return req;
     }
 
+    qdb_request & batchOptions(qdb_request & req)
+    {
+        req.input.content.batch = _eater.eatAndConvertBatchOptions();
+        return req;
+    }
+
+    qdb_request & deadline(qdb_request & req)
+    {
+        req.input.expiry = _eater.eatAndConvertDeadline();
+        return req;
+    }
+
     qdb_request & holder(qdb_request & req)
     {
         req.holder.Reset(v8::Isolate::GetCurrent(), _eater.eatHolder());
@@ -602,31 +878,51 @@ public:
 
     qdb_request & doublePoints(qdb_request & req)
     {
-        req.input.content.double_points = _eater.eatAndConvertDoublePointsArray();
+        _eater.eatAndConvertDoublePointsArray(req.input.content.double_points);
         return req;
     }
 
     qdb_request & blobPoints(qdb_request & req)
     {
-        req.input.content.blob_points = _eater.eatAndConvertBlobPointsArray();
+        _eater.eatAndConvertBlobPointsArray(req.input.content.blob_points);
+        req.pin(v8::Isolate::GetCurrent(), _eater.pinned());
         return req;
     }
 
     qdb_request & stringPoints(qdb_request & req)
     {
-        req.input.content.string_points = _eater.eatAndConvertStringPointsArray();
+        _eater.eatAndConvertStringPointsArray(req.input.content.string_points);
+        req.pin(v8::Isolate::GetCurrent(), _eater.pinned());
+        return req;
+    }
+
+    qdb_request & doubleColumnarPoints(qdb_request & req)
+    {
+        req.input.content.columnar = _eater.eatAndConvertColumnarPoints(&v8::Value::IsFloat64Array);
+        return req;
+    }
+
+    qdb_request & int64ColumnarPoints(qdb_request & req)
+    {
+        req.input.content.columnar = _eater.eatAndConvertColumnarPoints(&v8::Value::IsBigInt64Array);
+        return req;
+    }
+
+    qdb_request & timestampColumnarPoints(qdb_request & req)
+    {
+        req.input.content.columnar = _eater.eatAndConvertColumnarPoints(&v8::Value::IsBigInt64Array);
         return req;
     }
 
     qdb_request & int64Points(qdb_request & req)
     {
-        req.input.content.int64_points = _eater.eatAndConvertInt64PointsArray();
+        _eater.eatAndConvertInt64PointsArray(req.input.content.int64_points);
         return req;
     }
 
     qdb_request & timestampPoints(qdb_request & req)
     {
-        req.input.content.timestamp_points = _eater.eatAndConvertTimestampPointsArray();
+        _eater.eatAndConvertTimestampPointsArray(req.input.content.timestamp_points);
         return req;
     }
 
@@ -636,6 +932,18 @@ public:
         return req;
     }
 
+    qdb_request & downsampleOptions(qdb_request & req)
+    {
+        req.input.content.downsample = _eater.eatAndConvertDownsampleOptions();
+        return req;
+    }
+
+    qdb_request & kernels(qdb_request & req)
+    {
+        req.input.content.kernels = _eater.eatAndConvertKernelArray();
+        return req;
+    }
+
     qdb_request & blobAggregations(qdb_request & req)
     {
         req.input.content.blob_aggrs = _eater.eatAndConvertAggrArray<qdb_ts_blob_aggregation_t>();
@@ -666,12 +974,6 @@ public:
         return req;
     }
 
-    qdb_request & tsAlias(qdb_request & req)
-    {
-        req.input.content.str = _eater.eatAndConvertTsAlias();
-        return req;
-    }
-
     bool bindCallback(qdb_request & req)
     {
         auto callback = _eater.eatCallback();
@@ -108,6 +108,39 @@ describe('Blob', function () {
             });
         });
 
+        it('should get part of the value', function (done) {
+            b.getRange(4, 3, function (err, data) {
+                test.must(err).be.equal(null);
+
+                test.must(data.toString()).be.equal('con');
+
+                done();
+            });
+        });
+
+        it('should clip the part to the value size', function (done) {
+            b.getRange(8, 100, function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data.toString()).be.equal('ent');
+
+                b.getRange(100, 1, function (err, data) {
+                    test.must(err).be.equal(null);
+                    test.must(data.length).be.equal(0);
+
+                    done();
+                });
+            });
+        });
+
+        it('should not get a part with a negative offset', function (done) {
+            b.getRange(-1, 3, function (err, data) {
+                test.must(err).not.be.equal(null);
+                test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+
+                done();
+            });
+        });
+
         it('should remove without error', function (done) {
             b.remove(function (err) {
                 test.must(err).be.equal(null);
@@ -439,3 +472,622 @@ describe('blob', function () {
     }); // expiry
 
 }); // blob
+
+describe('blob atomic operations', function () {
+    var b = null;
+
+    before('connect', function (done) {
+        insecureCluster.connect(done, done);
+    });
+
+    before('init', function (done) {
+        b = insecureCluster.blob('atomic_bam');
+        b.update(Buffer.from('first'), function (err) {
+            test.must(err).be.equal(null);
+            done();
+        });
+    });
+
+    it('should swap when the comparand matches', function (done) {
+        b.compareAndSwap(Buffer.from('second'), Buffer.from('first'), function (err, data) {
+            test.must(err).be.equal(null);
+            test.must(data.length).be.equal(0);
+
+            done();
+        });
+    });
+
+    it('should return the current content when the comparand does not match', function (done) {
+        b.compareAndSwap(Buffer.from('third'), Buffer.from('first'), function (err, data) {
+            test.must(err).not.be.equal(null);
+            test.must(err.code).be.equal(qdb.E_UNMATCHED_CONTENT);
+            test.must(data.toString()).be.equal('second');
+
+            done();
+        });
+    });
+
+    it('should get the previous content when updating', function (done) {
+        b.getAndUpdate(Buffer.from('third'), function (err, data) {
+            test.must(err).be.equal(null);
+            test.must(data.toString()).be.equal('second');
+
+            done();
+        });
+    });
+
+    it('should not remove when the comparand does not match', function (done) {
+        b.removeIf(Buffer.from('second'), function (err) {
+            test.must(err).not.be.equal(null);
+            test.must(err.code).be.equal(qdb.E_UNMATCHED_CONTENT);
+
+            done();
+        });
+    });
+
+    it('should get the content when removing', function (done) {
+        b.getAndRemove(function (err, data) {
+            test.must(err).be.equal(null);
+            test.must(data.toString()).be.equal('third');
+
+            b.get(function (err) {
+                test.must(err.code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+
+                done();
+            });
+        });
+    });
+
+    it('should remove when the comparand matches', function (done) {
+        b.put(Buffer.from('lease'), function (err) {
+            test.must(err).be.equal(null);
+
+            b.removeIf(Buffer.from('lease'), function (err) {
+                test.must(err).be.equal(null);
+
+                done();
+            });
+        });
+    });
+});
+
+describe('blob codec', function () {
+    var content = Buffer.from(JSON.stringify(new Array(200).fill({ name: 'bam', value: 'bam_content' })));
+
+    before('connect', function (done) {
+        insecureCluster.connect(done, done);
+    });
+
+    after('reset', function () {
+        insecureCluster.setBlobCompression(qdb.COMPRESSION_NONE);
+    });
+
+    it('should not encode by default', function () {
+        test.must(insecureCluster.getBlobCompression()).be.equal(qdb.COMPRESSION_NONE);
+        test.must(insecureCluster.blob('codec_bam').getCompression()).be.equal(qdb.COMPRESSION_NONE);
+    });
+
+    it('should reject unknown codecs', function () {
+        test.exception(function () {
+            insecureCluster.setBlobCompression(42);
+        });
+        test.exception(function () {
+            insecureCluster.blob('codec_bam').setCompression(42);
+        });
+    });
+
+    it('should store compressed content and read it back', function (done) {
+        var b = insecureCluster.blob('codec_bam');
+        b.setCompression(qdb.COMPRESSION_DEFLATE);
+
+        b.update(content, function (err) {
+            test.must(err).be.equal(null);
+
+            b.getMetadata(function (err, meta) {
+                test.must(err).be.equal(null);
+                test.must(meta.size).be.below(content.length);
+
+                b.get(function (err, data) {
+                    test.must(err).be.equal(null);
+                    test.must(data.equals(content)).be.true();
+
+                    done();
+                });
+            });
+        });
+    });
+
+    it('should only decode when a codec is set', function (done) {
+        var b = insecureCluster.blob('codec_bam');
+
+        b.get(function (err, data) {
+            test.must(err).be.equal(null);
+            test.must(data.subarray(0, 4).equals(Buffer.from([0x89, 0x51, 0x44, 0x5a]))).be.true();
+
+            b.setCompression(qdb.COMPRESSION_DEFLATE);
+            b.getRange(2, 10, function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data.equals(content.subarray(2, 12))).be.true();
+
+                b.getAndRemove(function (err, data) {
+                    test.must(err).be.equal(null);
+                    test.must(data.equals(content)).be.true();
+
+                    done();
+                });
+            });
+        });
+    });
+
+    it('should not mistake raw content for encoded content without a codec', function (done) {
+        var b = insecureCluster.blob('codec_bam');
+        var raw = Buffer.concat([Buffer.from([0x89, 0x51, 0x44, 0x5a, 1, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0]), content]);
+
+        b.update(raw, function (err) {
+            test.must(err).be.equal(null);
+
+            b.get(function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data.equals(raw)).be.true();
+
+                b.remove(done);
+            });
+        });
+    });
+
+    it('should compare and swap compressed content', function (done) {
+        var b = insecureCluster.blob('codec_bam');
+        b.setCompression(qdb.COMPRESSION_DEFLATE);
+        var next = Buffer.concat([content, content]);
+
+        b.update(content, function (err) {
+            test.must(err).be.equal(null);
+
+            b.compareAndSwap(next, content, function (err) {
+                test.must(err).be.equal(null);
+
+                b.compareAndSwap(content, content, function (err, data) {
+                    test.must(err).not.be.equal(null);
+                    test.must(err.code).be.equal(qdb.E_UNMATCHED_CONTENT);
+                    test.must(data.equals(next)).be.true();
+
+                    b.getMetadata(function (err, meta) {
+                        test.must(err).be.equal(null);
+                        test.must(meta.size).be.below(next.length);
+
+                        b.removeIf(next, function (err) {
+                            test.must(err).be.equal(null);
+                            done();
+                        });
+                    });
+                });
+            });
+        });
+    });
+
+    it('should compare raw content with a codec set', function (done) {
+        var b = insecureCluster.blob('codec_bam');
+
+        b.update(content, function (err) {
+            test.must(err).be.equal(null);
+
+            b.setCompression(qdb.COMPRESSION_DEFLATE);
+            b.compareAndSwap(Buffer.from('bam'), content, function (err) {
+                test.must(err).be.equal(null);
+
+                b.get(function (err, data) {
+                    test.must(err).be.equal(null);
+                    test.must(data.toString()).be.equal('bam');
+
+                    b.remove(done);
+                });
+            });
+        });
+    });
+
+    it('should use the cluster codec for blobs without one', function (done) {
+        insecureCluster.setBlobCompression(qdb.COMPRESSION_DEFLATE);
+
+        var b = insecureCluster.blob('codec_bam');
+        test.must(b.getCompression()).be.equal(qdb.COMPRESSION_DEFLATE);
+
+        b.update(content, function (err) {
+            test.must(err).be.equal(null);
+
+            b.getMetadata(function (err, meta) {
+                test.must(err).be.equal(null);
+                test.must(meta.size).be.below(content.length);
+
+                b.remove(done);
+            });
+        });
+    });
+
+    it('should store content raw when it does not compress', function (done) {
+        var b = insecureCluster.blob('codec_bam');
+        b.setCompression(qdb.COMPRESSION_DEFLATE);
+
+        b.update(Buffer.from('bam'), function (err) {
+            test.must(err).be.equal(null);
+
+            b.getMetadata(function (err, meta) {
+                test.must(err).be.equal(null);
+                test.must(meta.size).be.equal(3);
+
+                b.remove(done);
+            });
+        });
+    });
+});
+
+describe('blob streams', function () {
+    var b = null;
+    var content = null;
+
+    before('connect', function (done) {
+        insecureCluster.connect(done, done);
+    });
+
+    before('init', function () {
+        b = insecureCluster.blob('stream_bam');
+
+        content = Buffer.alloc(100 * 1024 + 7);
+        for (var i = 0; i < content.length; i++) content[i] = i % 251;
+    });
+
+    var readAll = function (blob, options, callback) {
+        var chunks = [];
+        blob.createReadStream(options)
+            .on('data', function (data) { chunks.push(data); })
+            .on('error', function (err) { callback(err, null, chunks); })
+            .on('end', function () { callback(null, Buffer.concat(chunks), chunks); });
+    };
+
+    // the manifest is the magic bytes followed by JSON
+    var manifestOf = function (blob, callback) {
+        blob.get(function (err, data) {
+            test.must(err).be.equal(null);
+            callback(JSON.parse(data.subarray(8).toString()));
+        });
+    };
+
+    var chunkOf = function (manifest, index) {
+        return insecureCluster.blob('stream_bam.chunk.' + manifest.generation + '.' + index);
+    };
+
+    it('should write in chunks', function (done) {
+        var w = b.createWriteStream({ chunkSize: 16 * 1024 });
+
+        w.on('error', done);
+        w.write(content.subarray(0, 1000));
+        w.end(content.subarray(1000), function () {
+            manifestOf(b, function (manifest) {
+                test.must(manifest.chunks).be.equal(7);
+
+                chunkOf(manifest, 6).get(function (err, data) {
+                    test.must(err).be.equal(null);
+                    test.must(data.length).be.equal(content.length - 6 * 16 * 1024);
+
+                    done();
+                });
+            });
+        });
+    });
+
+    it('should read chunks back', function (done) {
+        readAll(b, {}, function (err, data, chunks) {
+            test.must(err).be.equal(null);
+            test.must(chunks.length).be.equal(7);
+            test.must(data.equals(content)).be.true();
+
+            done();
+        });
+    });
+
+    it('should only read the chunks of the requested part', function (done) {
+        readAll(b, { start: 20000, end: 40000 }, function (err, data, chunks) {
+            test.must(err).be.equal(null);
+            test.must(chunks.length).be.equal(2);
+            test.must(data.equals(content.subarray(20000, 40001))).be.true();
+
+            done();
+        });
+    });
+
+    it('should remove the chunks of the previous value', function (done) {
+        manifestOf(b, function (previous) {
+            b.createWriteStream({ chunkSize: 16 * 1024 }).end(Buffer.from('small'), function () {
+                manifestOf(b, function (manifest) {
+                    test.must(manifest.generation).not.be.equal(previous.generation);
+
+                    chunkOf(previous, 0).get(function (err) {
+                        test.must(err).not.be.equal(null);
+                        test.must(err.code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+
+                        readAll(b, {}, function (err, data) {
+                            test.must(err).be.equal(null);
+                            test.must(data.toString()).be.equal('small');
+
+                            done();
+                        });
+                    });
+                });
+            });
+        });
+    });
+
+    it('should fail when the blob changes during the write', function (done) {
+        var changed = insecureCluster.blob('stream_bam');
+        var get = changed.get;
+
+        // a concurrent writer replaces the value once the stream read it
+        changed.get = function (callback) {
+            get.call(changed, function (err, data) {
+                b.update(Buffer.from('concurrent'), function () {
+                    callback(err, data);
+                });
+            });
+        };
+
+        var w = changed.createWriteStream({ chunkSize: 16 * 1024 });
+        w.on('error', function (err) {
+            test.must(err.code).be.equal(qdb.E_UNMATCHED_CONTENT);
+
+            b.get(function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data.toString()).be.equal('concurrent');
+
+                b.createWriteStream({ chunkSize: 16 * 1024 }).end(content, done);
+            });
+        });
+        w.end(Buffer.from('lost'));
+    });
+
+    it('should remove a streamed blob with its chunks', function (done) {
+        manifestOf(b, function (manifest) {
+            b.removeStreamed(function (err) {
+                test.must(err).be.equal(null);
+
+                chunkOf(manifest, 0).get(function (err) {
+                    test.must(err).not.be.equal(null);
+                    test.must(err.code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+
+                    b.get(function (err) {
+                        test.must(err).not.be.equal(null);
+                        test.must(err.code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+
+                        done();
+                    });
+                });
+            });
+        });
+    });
+
+    it('should read a plain blob in slices', function (done) {
+        var plain = insecureCluster.blob('stream_plain_bam');
+        plain.update(Buffer.from('bam_content'), function (err) {
+            test.must(err).be.equal(null);
+
+            readAll(plain, { chunkSize: 4 }, function (err, data, chunks) {
+                test.must(err).be.equal(null);
+                test.must(chunks.length).be.equal(3);
+                test.must(data.toString()).be.equal('bam_content');
+
+                plain.remove(done);
+            });
+        });
+    });
+
+    it('should fail to read a missing blob', function (done) {
+        readAll(insecureCluster.blob('stream_missing_bam'), {}, function (err) {
+            test.must(err).not.be.equal(null);
+            test.must(err.code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+
+            done();
+        });
+    });
+
+    it('should read part of a plain blob', function (done) {
+        var plain = insecureCluster.blob('stream_plain_bam');
+        plain.update(Buffer.from('bam_content'), function (err) {
+            test.must(err).be.equal(null);
+
+            readAll(plain, { start: 4, end: 6 }, function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data.toString()).be.equal('con');
+
+                plain.remove(done);
+            });
+        });
+    });
+
+    it('should reject invalid chunk size', function () {
+        test.exception(function () {
+            b.createReadStream({ chunkSize: -1 });
+        });
+    });
+});
+
+describe('blob cache', function () {
+    var b;
+
+    before('connect', function (done) {
+        insecureCluster.connect(function () {
+            b = insecureCluster.blob('cache_bam');
+            done();
+        }, done);
+    });
+
+    after('disable', function (done) {
+        insecureCluster.disableBlobCache();
+        b.remove(function () {
+            done();
+        });
+    });
+
+    it('should be disabled by default', function () {
+        test.must(insecureCluster.blobCacheStats()).be.equal(null);
+    });
+
+    it('should reject invalid options', function () {
+        test.exception(function () {
+            insecureCluster.enableBlobCache({ maxBytes: 0 });
+        });
+        test.exception(function () {
+            insecureCluster.enableBlobCache({ maxAge: -1 });
+        });
+    });
+
+    it('should serve repeated gets from the cache', function (done) {
+        insecureCluster.enableBlobCache({ maxBytes: 1024 });
+
+        b.update(Buffer.from('bam_content'), function (err) {
+            test.must(err).be.equal(null);
+
+            b.get(function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data.toString()).be.equal('bam_content');
+
+                b.get(function (err, data) {
+                    test.must(err).be.equal(null);
+                    test.must(data.toString()).be.equal('bam_content');
+
+                    var stats = insecureCluster.blobCacheStats();
+                    test.must(stats.hits).be.equal(1);
+                    test.must(stats.misses).be.equal(1);
+                    test.must(stats.entries).be.equal(1);
+                    test.must(stats.bytes).be.equal(11);
+                    test.must(stats.maxBytes).be.equal(1024);
+
+                    done();
+                });
+            });
+        });
+    });
+
+    it('should hand out a copy of the cached content', function (done) {
+        b.get(function (err, data) {
+            test.must(err).be.equal(null);
+            data.fill(0);
+
+            b.get(function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data.toString()).be.equal('bam_content');
+                done();
+            });
+        });
+    });
+
+    it('should invalidate on update and remove', function (done) {
+        b.update(Buffer.from('new_bam_content'), function (err) {
+            test.must(err).be.equal(null);
+            test.must(insecureCluster.blobCacheStats().entries).be.equal(0);
+
+            b.get(function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data.toString()).be.equal('new_bam_content');
+
+                b.remove(function (err) {
+                    test.must(err).be.equal(null);
+
+                    b.get(function (err) {
+                        test.must(err).be.an.object();
+                        done();
+                    });
+                });
+            });
+        });
+    });
+
+    it('should evict least recently used contents', function (done) {
+        insecureCluster.enableBlobCache({ maxBytes: 16 });
+
+        var other = insecureCluster.blob('cache_other_bam');
+
+        b.update(Buffer.from('0123456789'), function (err) {
+            test.must(err).be.equal(null);
+            other.update(Buffer.from('abcdefghij'), function (err) {
+                test.must(err).be.equal(null);
+
+                b.get(function (err) {
+                    test.must(err).be.equal(null);
+                    other.get(function (err) {
+                        test.must(err).be.equal(null);
+
+                        var stats = insecureCluster.blobCacheStats();
+                        test.must(stats.evictions).be.equal(1);
+                        test.must(stats.entries).be.equal(1);
+                        test.must(stats.bytes).be.equal(10);
+
+                        other.remove(done);
+                    });
+                });
+            });
+        });
+    });
+
+    it('should not serve contents older than maxAge', function (done) {
+        insecureCluster.enableBlobCache({ maxAge: 20 });
+
+        b.get(function (err) {
+            test.must(err).be.equal(null);
+
+            setTimeout(function () {
+                b.get(function (err, data) {
+                    test.must(err).be.equal(null);
+                    test.must(data.toString()).be.equal('0123456789');
+                    test.must(insecureCluster.blobCacheStats().misses).be.equal(2);
+                    done();
+                });
+            }, 40);
+        });
+    });
+
+    it('should cache a get while another blob is written', function (done) {
+        insecureCluster.enableBlobCache({ maxBytes: 1024 });
+
+        var other = insecureCluster.blob('cache_other_bam');
+        var written = false;
+
+        b.get(function (err) {
+            test.must(err).be.equal(null);
+            if (written) check();
+            written = true;
+        });
+        other.update(Buffer.from('abcdefghij'), function (err) {
+            test.must(err).be.equal(null);
+            if (written) check();
+            written = true;
+        });
+
+        function check() {
+            test.must(insecureCluster.blobCacheStats().entries).be.equal(1);
+            other.remove(done);
+        }
+    });
+
+    it('should only serve contents to the blobs reading with the same compression', function (done) {
+        insecureCluster.enableBlobCache({ maxBytes: 64 * 1024 });
+
+        var compressed = insecureCluster.blob('cache_bam');
+        compressed.setCompression(qdb.COMPRESSION_DEFLATE);
+        var content = Buffer.alloc(4096, 'bam_');
+
+        compressed.update(content, function (err) {
+            test.must(err).be.equal(null);
+
+            compressed.get(function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data.equals(content)).be.true();
+
+                // without compression, the stored bytes are returned as they are
+                b.get(function (err, data) {
+                    test.must(err).be.equal(null);
+                    test.must(data.length).be.below(content.length);
+                    test.must(insecureCluster.blobCacheStats().hits).be.equal(0);
+                    done();
+                });
+            });
+        });
+    });
+});
@@ -1,5 +1,7 @@
 var test = require('unit.js');
 var qdb = require('..');
+var async_hooks = require('async_hooks');
+var diagnostics_channel = require('diagnostics_channel');
 var config = require('./config');
 
 describe('Cluster', function () {
@@ -75,4 +77,457 @@ describe('Cluster', function () {
             done();
         });
     }); // getTimeout
+
+    describe('expireMany', function () {
+        var aliases = ['expire_many_bam_0', 'expire_many_bam_1', 'expire_many_bam_2'];
+
+        before('create', function (done) {
+            insecureCluster.connect(function () {
+                var pending = aliases.length;
+                aliases.forEach(function (alias) {
+                    insecureCluster.blob(alias).update(Buffer.from(alias), function (err) {
+                        test.must(err).be.equal(null);
+                        if (--pending == 0) done();
+                    });
+                });
+            }, done);
+        });
+
+        after('remove', function (done) {
+            var pending = aliases.length;
+            aliases.forEach(function (alias) {
+                insecureCluster.blob(alias).remove(function () {
+                    if (--pending == 0) done();
+                });
+            });
+        });
+
+        it('should set the expiry of every entry at a given date', function (done) {
+            var expiry = new Date();
+            expiry.setMinutes(expiry.getMinutes() + 5);
+            expiry.setMilliseconds(0);
+
+            insecureCluster.expireMany(aliases, expiry, function (err, successCount, result) {
+                test.must(err).be.equal(null);
+                test.must(successCount).be.equal(3);
+                test.must(Object.keys(result).sort()).eql(aliases);
+                aliases.forEach(function (alias) {
+                    test.must(result[alias]).be.equal(null);
+                });
+
+                insecureCluster.blob(aliases[1]).getExpiry(function (err, entry_expiry) {
+                    test.must(err).be.equal(null);
+                    test.must(entry_expiry.getTime()).be.equal(expiry.getTime());
+
+                    done();
+                });
+            });
+        });
+
+        it('should set the expiry from now', function (done) {
+            var before = Date.now();
+
+            insecureCluster.expireMany(aliases, 60000, function (err, successCount) {
+                test.must(err).be.equal(null);
+                test.must(successCount).be.equal(3);
+
+                insecureCluster.blob(aliases[0]).getExpiry(function (err, entry_expiry) {
+                    test.must(err).be.equal(null);
+                    // the server keeps the expiry to the second
+                    test.must(entry_expiry.getTime()).be.between(before + 59000, Date.now() + 60000);
+
+                    done();
+                });
+            });
+        });
+
+        it('should report the status of every alias', function (done) {
+            var missing = 'expire_many_missing';
+
+            insecureCluster.expireMany([aliases[0], missing], 60000, function (err, successCount, result) {
+                test.must(err).be.equal(null);
+                test.must(successCount).be.equal(1);
+                test.must(result[aliases[0]]).be.equal(null);
+                test.must(result[missing].code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+
+                done();
+            });
+        });
+
+        it('should set the expiry in batches', function (done) {
+            var missing = 'expire_many_missing';
+
+            insecureCluster.expireMany(aliases.concat([missing]), 60000, { batchSize: 1 }, function (err, successCount, result) {
+                test.must(err).be.equal(null);
+                test.must(successCount).be.equal(3);
+                test.must(Object.keys(result).sort()).eql(aliases.concat([missing]));
+                test.must(result[missing].code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+
+                done();
+            });
+        });
+    }); // expireMany
+
+    describe('not found as null', function () {
+        var b = null;
+
+        before('connect', function (done) {
+            insecureCluster.connect(function () {
+                b = insecureCluster.blob('not_found_as_null_bam');
+                insecureCluster.setNotFoundAsNull(true);
+                done();
+            }, done);
+        });
+
+        after('restore', function () {
+            insecureCluster.setNotFoundAsNull(false);
+        });
+
+        it('should be enabled', function () {
+            test.must(insecureCluster.getNotFoundAsNull()).be.true();
+        });
+
+        it('should get null for a missing blob', function (done) {
+            b.get(function (err, data) {
+                test.must(err).be.equal(null);
+                test.must(data).be.equal(null);
+
+                done();
+            });
+        });
+
+        it('should get null metadata and expiry for a missing blob', function (done) {
+            b.getMetadata(function (err, meta) {
+                test.must(err).be.equal(null);
+                test.must(meta).be.equal(null);
+
+                b.getExpiry(function (err, expiry) {
+                    test.must(err).be.equal(null);
+                    test.must(expiry).be.equal(null);
+
+                    done();
+                });
+            });
+        });
+
+        it('should still fail to remove a missing blob', function (done) {
+            b.remove(function (err) {
+                test.must(err).be.instanceof(qdb.Error);
+                test.must(err.code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+                err.message.must.not.be.empty();
+
+                b.remove(function (again) {
+                    test.must(again.message).be.equal(err.message);
+
+                    done();
+                });
+            });
+        });
+
+        it('should get the content of an existing blob', function (done) {
+            b.put(Buffer.from('untz'), function (err) {
+                test.must(err).be.equal(null);
+
+                b.get(function (err, data) {
+                    test.must(err).be.equal(null);
+                    test.must(data.toString()).be.equal('untz');
+
+                    b.remove(done);
+                });
+            });
+        });
+    }); // not found as null
+
+    describe('stats', function () {
+        var b = null;
+
+        before('connect', function (done) {
+            insecureCluster.connect(function () {
+                b = insecureCluster.blob('stats_bam');
+                done();
+            }, done);
+        });
+
+        after('disable', function () {
+            insecureCluster.disableStats();
+        });
+
+        it('should be null when disabled', function () {
+            test.must(insecureCluster.stats()).be.equal(null);
+        });
+
+        it('should record the operations called', function (done) {
+            insecureCluster.enableStats();
+
+            b.put(Buffer.from('untz'), function (err) {
+                test.must(err).be.equal(null);
+
+                b.get(function (err) {
+                    test.must(err).be.equal(null);
+
+                    b.remove(function (err) {
+                        test.must(err).be.equal(null);
+
+                        b.get(function (err) {
+                            test.must(err).be.an.instanceof(qdb.Error);
+
+                            var stats = insecureCluster.stats();
+                            test.must(Object.keys(stats).sort()).eql(['Blob.get', 'Blob.put', 'Blob.remove']);
+
+                            var get = stats['Blob.get'];
+                            test.must(get.calls).be.equal(2);
+                            test.must(get.errors).be.equal(1);
+                            test.must(get.bytesOut).be.equal(4);
+                            test.must(stats['Blob.put'].bytesIn).be.equal(4);
+
+                            ['queue', 'execute', 'convert'].forEach(function (phase) {
+                                test.must(get[phase].count).be.equal(2);
+                                test.must(get[phase].p50).be.at.most(get[phase].p99);
+                                test.must(get[phase].p99).be.at.most(get[phase].max);
+                            });
+
+                            done();
+                        });
+                    });
+                });
+            });
+        });
+
+        it('should record the inserts of a column writer', function (done) {
+            var ts = insecureCluster.ts('stats_ts');
+
+            ts.create([qdb.DoubleColumnInfo('stats_column')], function (err, columns) {
+                test.must(err).be.equal(null);
+
+                var writer = columns[0].writer();
+                var points = [qdb.DoublePoint(qdb.Timestamp.fromDate(new Date(2049, 10, 6, 1)), 1.0)];
+
+                insecureCluster.enableStats();
+
+                writer.insert(points, function (err) {
+                    test.must(err).be.equal(null);
+
+                    writer.insert([], function (err) {
+                        test.must(err).be.an.instanceof(qdb.Error);
+
+                        var insert = insecureCluster.stats()['ColumnWriter.insert'];
+                        test.must(insert.calls).be.equal(2);
+                        test.must(insert.errors).be.equal(1);
+                        test.must(insert.execute.count).be.equal(2);
+
+                        ts.remove(function () {
+                            done();
+                        });
+                    });
+                });
+            });
+        });
+
+        it('should reset when enabled again', function () {
+            insecureCluster.enableStats();
+            test.must(insecureCluster.stats()).be.empty();
+        });
+    }); // stats
+
+    describe('tracing', function () {
+        var b = null;
+
+        before('connect', function (done) {
+            insecureCluster.connect(function () {
+                b = insecureCluster.blob('tracing_bam');
+                done();
+            }, done);
+        });
+
+        it('should call back in the async context of the call', function (done) {
+            var storage = new async_hooks.AsyncLocalStorage();
+
+            storage.run('untz', function () {
+                b.put(Buffer.from('untz'), function (err) {
+                    test.must(err).be.equal(null);
+                    test.must(storage.getStore()).be.equal('untz');
+                    done();
+                });
+            });
+        });
+
+        it('should publish the start and the end of the requests', function (done) {
+            var started = [];
+            var ended = [];
+            var onStart = function (message) {
+                started.push(message);
+            };
+            var onEnd = function (message) {
+                ended.push(message);
+            };
+
+            diagnostics_channel.subscribe('quasardb:request:start', onStart);
+            diagnostics_channel.subscribe('quasardb:request:end', onEnd);
+
+            b.get(function (err) {
+                diagnostics_channel.unsubscribe('quasardb:request:start', onStart);
+                diagnostics_channel.unsubscribe('quasardb:request:end', onEnd);
+
+                test.must(err).be.equal(null);
+                test.must(started.length).be.equal(1);
+                test.must(ended.length).be.equal(1);
+                test.must(ended[0]).be.equal(started[0]);
+                test.must(ended[0].operation).be.equal('Blob.get');
+                test.must(ended[0].alias).be.equal('tracing_bam');
+                test.must(ended[0].error).be.equal(null);
+                test.must(ended[0].duration).be.at.least(0);
+
+                b.remove(function (err) {
+                    test.must(err).be.equal(null);
+                    test.must(started.length).be.equal(1);
+                    done();
+                });
+            });
+        });
+
+        it('should trace the gets served from the blob cache', function (done) {
+            var storage = new async_hooks.AsyncLocalStorage();
+            var ended = [];
+            var onEnd = function (message) {
+                ended.push(message);
+            };
+
+            insecureCluster.enableBlobCache({ maxBytes: 1024 });
+
+            b.update(Buffer.from('untz'), function (err) {
+                test.must(err).be.equal(null);
+
+                b.get(function (err) {
+                    test.must(err).be.equal(null);
+                    diagnostics_channel.subscribe('quasardb:request:end', onEnd);
+
+                    storage.run('untz', function () {
+                        b.get(function (err, data) {
+                            diagnostics_channel.unsubscribe('quasardb:request:end', onEnd);
+                            insecureCluster.disableBlobCache();
+
+                            test.must(err).be.equal(null);
+                            test.must(data.toString()).be.equal('untz');
+                            test.must(storage.getStore()).be.equal('untz');
+                            test.must(ended.length).be.equal(1);
+                            test.must(ended[0].operation).be.equal('Blob.get');
+                            test.must(ended[0].error).be.equal(null);
+
+                            b.remove(function () {
+                                done();
+                            });
+                        });
+                    });
+                });
+            });
+        });
+
+        it('should trace the inserts of a column writer', function (done) {
+            var storage = new async_hooks.AsyncLocalStorage();
+            var ts = insecureCluster.ts('tracing_ts');
+            var ended = [];
+            var onEnd = function (message) {
+                ended.push(message);
+            };
+
+            ts.create([qdb.DoubleColumnInfo('tracing_column')], function (err, columns) {
+                test.must(err).be.equal(null);
+
+                var writer = columns[0].writer();
+                var points = [qdb.DoublePoint(qdb.Timestamp.fromDate(new Date(2049, 10, 6, 1)), 1.0)];
+
+                diagnostics_channel.subscribe('quasardb:request:end', onEnd);
+
+                storage.run('untz', function () {
+                    writer.insert(points, function (err) {
+                        test.must(err).be.equal(null);
+                        test.must(storage.getStore()).be.equal('untz');
+
+                        // every insert of the writer runs in the context it was issued from
+                        storage.run('bam', function () {
+                            writer.insert(points, function (err) {
+                                diagnostics_channel.unsubscribe('quasardb:request:end', onEnd);
+
+                                test.must(err).be.equal(null);
+                                test.must(storage.getStore()).be.equal('bam');
+                                test.must(ended.length).be.equal(2);
+                                test.must(ended[1].operation).be.equal('ColumnWriter.insert');
+                                test.must(ended[1].alias).be.equal('tracing_column');
+
+                                ts.remove(function () {
+                                    done();
+                                });
+                            });
+                        });
+                    });
+                });
+            });
+        });
+    }); // tracing
+
+    describe('conversion watchdog', function () {
+        var b = null;
+
+        before('connect', function (done) {
+            insecureCluster.connect(function () {
+                b = insecureCluster.blob('watchdog_bam');
+                done();
+            }, done);
+        });
+
+        after('disable', function () {
+            insecureCluster.disableConversionWatchdog();
+        });
+
+        it('should reject an invalid threshold', function () {
+            test.must(function () {
+                insecureCluster.enableConversionWatchdog(-1, function () {});
+            }).throw(Error);
+        });
+
+        it('should report the conversions reaching the threshold', function (done) {
+            var reports = [];
+            insecureCluster.enableConversionWatchdog(0, function (report) {
+                reports.push(report);
+            });
+
+            b.put(Buffer.from('untz'), function (err) {
+                test.must(err).be.equal(null);
+
+                b.get(function (err, data) {
+                    test.must(err).be.equal(null);
+
+                    var phases = reports.filter(function (report) {
+                        return report.operation === 'Blob.get';
+                    }).map(function (report) {
+                        test.must(report.alias).be.equal('watchdog_bam');
+                        test.must(report.duration).be.at.least(0);
+                        return report.phase;
+                    });
+                    test.must(phases).eql(['arguments', 'result']);
+
+                    var put = reports.filter(function (report) {
+                        return (report.operation === 'Blob.put') && (report.phase === 'arguments');
+                    });
+                    test.must(put[0].count).be.equal(4);
+
+                    done();
+                });
+            });
+        });
+
+        it('should stop reporting when disabled', function (done) {
+            var reports = 0;
+            insecureCluster.enableConversionWatchdog(0, function () {
+                ++reports;
+            });
+            insecureCluster.disableConversionWatchdog();
+
+            b.remove(function (err) {
+                test.must(err).be.equal(null);
+                test.must(reports).be.equal(0);
+                done();
+            });
+        });
+    }); // conversion watchdog
 });
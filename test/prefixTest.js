@@ -105,4 +105,159 @@ describe('Prefix', function () {
             });
         });
     }); // getEntries
+
+    describe("cluster.prefixes()", function () {
+        it('should look up every prefix', function (done) {
+            insecureCluster.prefixes([prefix, prefix + '1', 'not matching'], 100, function (err, result) {
+                test.must(err).be.equal(null);
+                test.must(Object.keys(result).sort()).eql([prefix, prefix + '1', 'not matching'].sort());
+                test.must(result[prefix].filter(function (a) {
+                    return matchingAliases.indexOf(a) >= 0;
+                }).sort()).eql(matchingAliases);
+                test.must(result[prefix + '1']).eql([prefix + '1']);
+                test.must(result['not matching']).be.empty();
+
+                done();
+            });
+        });
+
+        it('should return every alias once when deduplicating', function (done) {
+            insecureCluster.prefixes([prefix + '1', prefix], 100, { dedupe: true }, function (err, result) {
+                test.must(err).be.equal(null);
+                test.must(result[prefix + '1']).eql([prefix + '1']);
+                test.must(result[prefix].indexOf(prefix + '1')).be.equal(-1);
+                test.must(result[prefix].indexOf(prefix + '2')).be.gte(0);
+
+                done();
+            });
+        });
+
+        it('should keep the aliases of a prefix given twice when deduplicating', function (done) {
+            insecureCluster.prefixes([prefix + '1', prefix + '1'], 100, { dedupe: true }, function (err, result) {
+                test.must(err).be.equal(null);
+                test.must(Object.keys(result)).eql([prefix + '1']);
+                test.must(result[prefix + '1']).eql([prefix + '1']);
+
+                done();
+            });
+        });
+
+        it('should return __proto__ as a plain field', function (done) {
+            insecureCluster.prefixes(['__proto__'], 100, function (err, result) {
+                test.must(err).be.equal(null);
+                test.must(Object.getPrototypeOf(result)).be.equal(Object.prototype);
+                test.must(Object.keys(result)).eql(['__proto__']);
+                test.must(result['__proto__']).be.empty();
+
+                done();
+            });
+        });
+    }); // cluster.prefixes
+
+    describe("count()", function () {
+        it('should count the aliases', function (done) {
+            p.count(function (err, count) {
+                test.must(err).be.equal(null);
+                test.must(count).be.equal(matchingAliases.length);
+
+                done();
+            });
+        });
+
+        it('should count zero aliases when nothing matches', function (done) {
+            insecureCluster.prefix('not matching').count(function (err, count) {
+                test.must(err).be.equal(null);
+                test.must(count).be.equal(0);
+
+                done();
+            });
+        });
+    }); // count
+
+    describe("getEntriesPacked()", function () {
+        it('should return the aliases packed in a buffer', function (done) {
+            p.getEntriesPacked(/*maxCount=*/100, function (err, data, offsets) {
+                test.must(err).be.equal(null);
+                test.must(offsets).be.instanceof(Uint32Array);
+                test.must(offsets.length).be.equal(matchingAliases.length + 1);
+                test.must(offsets[0]).be.equal(0);
+                test.must(offsets[matchingAliases.length]).be.equal(data.length);
+
+                var aliases = [];
+                for (var i = 0; i < matchingAliases.length; ++i) {
+                    aliases.push(data.toString('utf8', offsets[i], offsets[i + 1]));
+                }
+                test.must(aliases.sort()).eql(matchingAliases);
+
+                done();
+            });
+        });
+
+        it('should return E_ALIAS_NOT_FOUND and an empty buffer', function (done) {
+            insecureCluster.prefix('not matching').getEntriesPacked(10, function (err, data, offsets) {
+                test.must(err.code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+                test.must(data.length).be.equal(0);
+                test.must(offsets.length).be.equal(0);
+
+                done();
+            });
+        });
+    }); // getEntriesPacked
+
+    describe("iterate()", function () {
+        var iterPrefix = 'prefix_iter_';
+        var iterAliases = [iterPrefix];
+        for (var i = 0; i < 30; ++i) {
+            iterAliases.push(iterPrefix + (i % 3) + '_' + i);
+        }
+
+        function collect(pages) {
+            var all = [];
+            var tokens = [];
+            var counts = [];
+            return (async function () {
+                for await (var page of pages) {
+                    test.must(page.aliases.length).be.at.most(4);
+                    all = all.concat(page.aliases);
+                    tokens.push(page.token);
+                    counts.push(page.aliases.length);
+                }
+                return { aliases: all, tokens: tokens, counts: counts };
+            })();
+        }
+
+        before('put samples', function () {
+            return Promise.all(iterAliases.map(put_blob));
+        });
+
+        it('should enumerate every alias in pages', function () {
+            return collect(insecureCluster.prefix(iterPrefix).iterate({ pageSize: 4 })).then(function (res) {
+                test.must(res.aliases.slice().sort()).eql(iterAliases.slice().sort());
+                test.must(res.tokens[res.tokens.length - 1]).be.equal(null);
+            });
+        });
+
+        it('should resume from a token', function () {
+            var lookup = insecureCluster.prefix(iterPrefix);
+            return collect(lookup.iterate({ pageSize: 4 })).then(function (first) {
+                // resumes after the third page
+                var seen = first.counts[0] + first.counts[1] + first.counts[2];
+                return collect(lookup.iterate({ pageSize: 4, token: first.tokens[2] })).then(function (rest) {
+                    test.must(rest.aliases.slice().sort()).eql(first.aliases.slice(seen).sort());
+                });
+            });
+        });
+
+        it('should end right away when nothing matches', function () {
+            return collect(insecureCluster.prefix('not matching').iterate()).then(function (res) {
+                test.must(res.aliases).be.empty();
+            });
+        });
+
+        it('should reject an invalid page size', function () {
+            test.exception(function () {
+                p.iterate({ pageSize: -1 });
+            });
+        });
+    }); // iterate
 });
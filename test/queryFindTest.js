@@ -62,6 +62,15 @@ describe('QueryFind', function (done) {
         });
     });
 
+    it('should count the matches without retrieving them', function (done) {
+        var query = "find(Tag='" + my_tag1 + "' AND type=blob)";
+        cluster.queryFind(query).count(function (err, count) {
+            test.must(err).be.equal(null);
+            test.must(count).be.equal(1);
+            done();
+        });
+    });
+
     it('should return the alias name when querying with a single tag1', function (done) {
         var query = "find(Tag='" + my_tag1 + "')";
         cluster.queryFind(query).run(function (err, output) {
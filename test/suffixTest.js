@@ -96,4 +96,24 @@ describe('Suffix', function () {
       });
     });
   }); // getEntries
+
+  describe("iterate()", function () {
+    var iterSuffix = '_suffix_iter';
+    var iterAliases = [];
+    for (var i = 0; i < 12; ++i) {
+      iterAliases.push(i + iterSuffix);
+    }
+
+    before('put samples', function () { return Promise.all(iterAliases.map(put_blob)); });
+
+    it('should enumerate every alias in pages', async function () {
+      var all = [];
+      for await (var page of insecureCluster.suffix(iterSuffix).iterate({ pageSize: 5 })) {
+        test.must(page.aliases.length).be.at.most(5);
+        all = all.concat(page.aliases);
+      }
+
+      test.must(all.sort()).eql(iterAliases.slice().sort());
+    });
+  }); // iterate
 });
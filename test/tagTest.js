@@ -122,6 +122,43 @@ describe('Tag', function () {
       });
     });
 
+    it('should count the entries', function (done) {
+      t.count(function (err, count) {
+        test.must(err).be.equal(null);
+        test.must(count).be.equal(3);
+
+        done();
+      });
+    });
+
+    it('should return the entries of many tags', function (done) {
+      insecureCluster.tagsEntries([dasTag, 'u96_empty'], function (err, result) {
+        test.must(err).be.equal(null);
+        test.must(result[dasTag].sort()).eql(['blob_tag_test', 'int_tag_test', 'time_series_tag_test']);
+        test.must(result['u96_empty']).be.empty();
+
+        done();
+      });
+    });
+
+    it('should return the whole list of entries packed', function (done) {
+      t.getEntriesPacked(function (err, data, offsets) {
+        test.must(err).be.equal(null);
+        test.must(offsets).be.instanceof(Uint32Array);
+        test.must(offsets.length).be.equal(4);
+        test.must(offsets[3]).be.equal(data.length);
+
+        var entries = [];
+        for (var k = 0; k < 3; ++k) {
+          entries.push(data.toString('utf8', offsets[k], offsets[k + 1]));
+        }
+
+        test.must(entries.sort()).eql(['blob_tag_test', 'int_tag_test', 'time_series_tag_test']);
+
+        done();
+      });
+    });
+
     it('should untag the blob successfully', function (done) {
       b.detachTag(dasTag, function (err) {
         test.must(err).be.equal(null);
@@ -338,4 +375,59 @@ describe('Tag', function () {
 
   }); // multiple tags
 
+  describe('many entries', function () {
+    var manyTag = 'line720_many';
+    var aliases = ['blob_many_tag_0', 'blob_many_tag_1', 'blob_many_tag_2'];
+
+    before('init', function (done) {
+      var created = 0;
+      aliases.forEach(function (alias) {
+        insecureCluster.blob(alias).update(new Buffer('untz'), function (err) {
+          test.must(err).be.equal(null);
+          if (++created == aliases.length) done();
+        });
+      });
+    });
+
+    it('should attach the tag to every entry', function (done) {
+      insecureCluster.attachTagToMany(aliases.concat(['blob_many_tag_missing']), manyTag, {batchSize: 2},
+        function (err, success_count, result) {
+          test.must(err).be.equal(null);
+          test.must(success_count).be.equal(aliases.length);
+
+          for (var i = 0; i < aliases.length; i++) {
+            test.must(result[aliases[i]]).be.equal(null);
+          }
+          test.must(result['blob_many_tag_missing']).be.instanceof(qdb.Error);
+          test.must(result['blob_many_tag_missing'].code).be.equal(qdb.E_ALIAS_NOT_FOUND);
+
+          done();
+        });
+    });
+
+    it('should list the tagged entries', function (done) {
+      insecureCluster.tag(manyTag).getEntries(function (err, entries) {
+        test.must(err).be.equal(null);
+        test.must(entries.sort()).eql(aliases);
+
+        done();
+      });
+    });
+
+    it('should detach the tag from every entry', function (done) {
+      insecureCluster.detachTagFromMany(aliases, manyTag, function (err, success_count, result) {
+        test.must(err).be.equal(null);
+        test.must(success_count).be.equal(aliases.length);
+
+        insecureCluster.tag(manyTag).getEntries(function (err, entries) {
+          test.must(err).be.equal(null);
+          entries.must.have.length(0);
+
+          done();
+        });
+      });
+    });
+
+  }); // many entries
+
 }); // tag
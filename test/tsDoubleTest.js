@@ -193,6 +193,122 @@ describe('Timeseries - Double', function () {
                 done();
             });
         });
+
+        it('should insert plain object points', function (done) {
+            var date = new Date(2049, 10, 5, 4);
+            var points = [
+                { timestamp: BigInt(date.getTime()) * 1000000n + 1n, value: 1.0 },
+                { timestamp: date.getTime() + 1, value: 2.0 },
+                { timestamp: new Date(date.getTime() + 2), value: 3.0 },
+                { timestamp: qdb.Timestamp.fromDate(new Date(2049, 10, 5, 5)), value: 4.0 }
+            ];
+
+            column.insert(points, function (err) {
+                test.must(err).be.equal(null);
+
+                done();
+            });
+        });
+
+        it('should not insert points with invalid timestamps', function (done) {
+            column.insert([{ timestamp: '2049-11-05', value: 1.0 }], function (err) {
+                test.must(err).not.be.equal(null);
+                test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+
+                done();
+            });
+        });
+
+        it('should insert columnar typed arrays', function (done) {
+            var start = BigInt(new Date(2049, 10, 5, 6).getTime()) * 1000000n;
+            var timestamps = new BigInt64Array([start, start + 1n, start + 2n]);
+            var values = new Float64Array([1.0, 2.0, 3.0]);
+
+            column.insertColumnar({ timestamps: timestamps, values: values }, function (err) {
+                test.must(err).be.equal(null);
+
+                done();
+            });
+        });
+
+        it('should not insert columnar arrays of different lengths', function (done) {
+            var timestamps = new BigInt64Array([1n, 2n]);
+
+            column.insertColumnar({ timestamps: timestamps, values: new Float64Array([1.0]) }, function (err) {
+                test.must(err).not.be.equal(null);
+                test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+
+                done();
+            });
+        });
+
+        it('should not insert columnar values of the wrong type', function (done) {
+            var timestamps = new BigInt64Array([1n, 2n]);
+
+            column.insertColumnar({ timestamps: timestamps, values: [1.0, 2.0] }, function (err) {
+                test.must(err).not.be.equal(null);
+                test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+
+                done();
+            });
+        });
+
+        it('should create writer bound to column', function () {
+            var writer = column.writer();
+
+            test.object(writer).isInstanceOf(qdb.ColumnWriter);
+            test.must(writer.timeseries).be.equal(ts.alias());
+            test.must(writer.column).be.equal(column.alias());
+            test.must(writer.pending).be.false();
+        });
+
+        it('should insert successive batches with writer', function (done) {
+            var writer = column.writer();
+            var batches = 3;
+
+            var insertBatch = function (batch) {
+                var points = [
+                    qdb.DoublePoint(qdb.Timestamp.fromDate(new Date(2049, 10, 6, batch, 1)), batch + 0.1),
+                    qdb.DoublePoint(qdb.Timestamp.fromDate(new Date(2049, 10, 6, batch, 2)), batch + 0.2)
+                ];
+
+                writer.insert(points, function (err) {
+                    test.must(err).be.equal(null);
+                    test.must(writer.pending).be.false();
+
+                    if (batch + 1 == batches) {
+                        done();
+                    } else {
+                        insertBatch(batch + 1);
+                    }
+                });
+                test.must(writer.pending).be.true();
+            };
+
+            insertBatch(0);
+        });
+
+        it('should not insert with writer while an insert is pending', function (done) {
+            var writer = column.writer();
+            var points = [qdb.DoublePoint(qdb.Timestamp.fromDate(new Date(2049, 10, 7, 1)), 1.0)];
+
+            writer.insert(points, function (err) {
+                test.must(err).be.equal(null);
+                done();
+            });
+
+            test.exception(function () {
+                writer.insert(points, function (err) {});
+            });
+        });
+
+        it('should not insert empty points with writer', function (done) {
+            column.writer().insert([], function (err) {
+                test.must(err).not.be.equal(null);
+                test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+                done();
+            });
+        });
     }); // insert
     
 
@@ -316,6 +432,196 @@ describe('Timeseries - Double', function () {
 
     }); // ranges
 
+    describe('downsampling', function () {
+        var ts = null
+        var column = null
+        var range = null
+        var insertedPoints = null
+
+        before('init', function (done) {
+            ts = insecureCluster.ts('ts')
+            range = qdb.TsRange(
+                qdb.Timestamp.fromDate(new Date(2049, 10, 5, 0)),
+                qdb.Timestamp.fromDate(new Date(2049, 10, 6, 0))
+            );
+            ts.remove(function (err) {
+                ts.create([qdb.DoubleColumnInfo('col')], function (err, cols) {
+                    test.should(err).be.equal(null);
+                    test.should(cols.length).eql(1);
+
+                    column = cols[0];
+                    done();
+                });
+            })
+        });
+
+        it('should insert double points', function (done) {
+            insertedPoints = [];
+            for (var i = 0; i < 100; i++) {
+                var value = (i == 42) ? 1000.0 : (i % 10);
+                insertedPoints.push(qdb.DoublePoint(qdb.Timestamp.fromDate(new Date(2049, 10, 5, 1, i)), value));
+            }
+
+            column.insert(insertedPoints, function (err) {
+                test.must(err).be.equal(null);
+                done();
+            });
+        });
+
+        it('should reduce with lttb and keep first, last and peak points', function (done) {
+            column.rangesDownsampled([range], {method: 'lttb', buckets: 10}, function (err, points) {
+                test.must(err).be.equal(null);
+                test.should(points.length).eql(10);
+
+                test.should(points[0]).eql(insertedPoints[0]);
+                test.should(points[9]).eql(insertedPoints[99]);
+                test.must(points.some(function (p) { return p.value == 1000.0; })).be.true();
+                done();
+            });
+        });
+
+        it('should reduce with minmax', function (done) {
+            column.rangesDownsampled([range], {method: 'minmax', buckets: 10}, function (err, points) {
+                test.must(err).be.equal(null);
+                test.should(points.length).eql(20);
+
+                for (var i = 0; i < points.length; i += 2) {
+                    test.should(points[i].value).eql(0.0);
+                    test.should(points[i + 1].value).eql(i == 8 ? 1000.0 : 9.0);
+                }
+                done();
+            });
+        });
+
+        it('should reduce with avg', function (done) {
+            column.rangesDownsampled([range], {method: 'avg', buckets: 10}, function (err, points) {
+                test.must(err).be.equal(null);
+                test.should(points.length).eql(10);
+
+                for (var i = 0; i < points.length; i++) {
+                    test.should(points[i].timestamp).eql(insertedPoints[i * 10].timestamp);
+                    test.should(points[i].value).eql(i == 4 ? 104.3 : 4.5);
+                }
+                done();
+            });
+        });
+
+        it('should return all points when there are fewer than buckets', function (done) {
+            column.rangesDownsampled([range], {method: 'lttb', buckets: 1000}, function (err, points) {
+                test.must(err).be.equal(null);
+                test.array(points).is(insertedPoints);
+                done();
+            });
+        });
+
+        it('should fail on unknown method', function (done) {
+            column.rangesDownsampled([range], {method: 'median', buckets: 10}, function (err, points) {
+                test.must(err).not.be.equal(null);
+                test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+                test.must(points).be.empty();
+                done();
+            });
+        });
+
+        it('should fail on invalid buckets', function (done) {
+            var options = [{method: 'lttb', buckets: 10.5}, {method: 'avg', buckets: 1e7},
+                {method: 'minmax', buckets: NaN}];
+            var remaining = options.length;
+
+            options.forEach(function (option) {
+                column.rangesDownsampled([range], option, function (err, points) {
+                    test.must(err).not.be.equal(null);
+                    test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+                    test.must(points).be.empty();
+                    if (--remaining == 0) done();
+                });
+            });
+        });
+    }); // downsampling
+
+    describe('compute', function () {
+        var ts = null
+        var column = null
+        var range = null
+
+        before('init', function (done) {
+            ts = insecureCluster.ts('ts')
+            range = qdb.TsRange(
+                qdb.Timestamp.fromDate(new Date(2049, 10, 5, 0)),
+                qdb.Timestamp.fromDate(new Date(2049, 10, 6, 0))
+            );
+            ts.remove(function (err) {
+                ts.create([qdb.DoubleColumnInfo('col')], function (err, cols) {
+                    test.should(err).be.equal(null);
+                    test.should(cols.length).eql(1);
+
+                    column = cols[0];
+
+                    // one point per minute, values 1 to 11
+                    var points = [];
+                    for (var i = 0; i < 11; i++) {
+                        points.push(qdb.DoublePoint(qdb.Timestamp.fromDate(new Date(2049, 10, 5, 1, i)), i + 1.0));
+                    }
+                    column.insert(points, function (err) {
+                        test.must(err).be.equal(null);
+                        done();
+                    });
+                });
+            })
+        });
+
+        it('should compute percentiles, ewma and rate', function (done) {
+            var ops = [{op: 'percentile', p: 50}, {op: 'percentile', p: 95}, {op: 'ewma', alpha: 1}, {op: 'rate'}];
+
+            column.compute([range], ops, function (err, results) {
+                test.must(err).be.equal(null);
+                test.should(results.length).eql(4);
+
+                test.should(results[0]).eql(6.0);
+                test.should(results[1]).eql(10.5);
+                test.should(results[2]).eql(11.0);
+                test.should(results[3]).eql(10.0 / 600.0);
+                done();
+            });
+        });
+
+        it('should compute histogram', function (done) {
+            column.compute([range], [{op: 'histogram', buckets: 2, min: 0, max: 10}], function (err, results) {
+                test.must(err).be.equal(null);
+                test.should(results.length).eql(1);
+
+                test.should(results[0].min).eql(0);
+                test.should(results[0].max).eql(10);
+                test.should(results[0].counts).eql([4, 6]);
+                done();
+            });
+        });
+
+        it('should fail on invalid histogram buckets', function (done) {
+            var ops = [{op: 'histogram', buckets: Infinity}, {op: 'histogram', buckets: NaN},
+                {op: 'histogram', buckets: 2.5}, {op: 'histogram', buckets: 1e7}];
+            var remaining = ops.length;
+
+            ops.forEach(function (op) {
+                column.compute([range], [op], function (err, results) {
+                    test.must(err).not.be.equal(null);
+                    test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+                    test.must(results).be.empty();
+                    if (--remaining == 0) done();
+                });
+            });
+        });
+
+        it('should fail on invalid kernel', function (done) {
+            column.compute([range], [{op: 'percentile', p: 101}], function (err, results) {
+                test.must(err).not.be.equal(null);
+                test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+                test.must(results).be.empty();
+                done();
+            });
+        });
+    }); // compute
+
     describe('aggregations', function () {
         var ts = null
         var column = null
@@ -397,5 +703,29 @@ describe('Timeseries - Double', function () {
             });
         });
 
+        it('should return columnar first, last and sum of double points', function (done) {
+            var aggrs = [
+                qdb.Aggregation(qdb.AggFirst, range),
+                qdb.Aggregation(qdb.AggLast, range),
+                qdb.Aggregation(qdb.AggSum, range)
+            ];
+
+            column.aggregateColumnar(aggrs, function (err, results) {
+                test.should(err).be.equal(null);
+                test.must(results.values).be.an.instanceof(Float64Array);
+                test.must(results.counts).be.an.instanceof(Float64Array);
+                test.must(results.timestamps).be.an.instanceof(BigInt64Array);
+                test.should(results.values.length).eql(3);
+
+                test.should(results.values[2]).eql(15.0);
+                test.should(results.counts[2]).eql(5);
+
+                var first = insertedPoints[3].timestamp;
+                test.should(results.timestamps[0]).eql(BigInt(first.seconds) * 1000000000n + BigInt(first.nanoseconds));
+
+                done();
+            });
+        });
+
     }); //aggregations
 });
\ No newline at end of file
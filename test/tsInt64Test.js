@@ -316,6 +316,53 @@ describe('Timeseries - Int64', function () {
 
     }); // ranges
 
+    describe('compute', function () {
+        var ts = null
+        var column = null
+        var range = null
+
+        before('init', function (done) {
+            ts = insecureCluster.ts('ts')
+            range = qdb.TsRange(
+                qdb.Timestamp.fromDate(new Date(2049, 10, 5, 0)),
+                qdb.Timestamp.fromDate(new Date(2049, 10, 6, 0))
+            );
+            ts.remove(function (err) {
+                ts.create([qdb.Int64ColumnInfo('col')], function (err, cols) {
+                    test.should(err).be.equal(null);
+                    test.should(cols.length).eql(1);
+
+                    column = cols[0];
+
+                    var points = [];
+                    for (var i = 0; i < 5; i++) {
+                        points.push(qdb.Int64Point(qdb.Timestamp.fromDate(new Date(2049, 10, 5, 1, 0, i)), i * 10));
+                    }
+                    column.insert(points, function (err) {
+                        test.must(err).be.equal(null);
+                        done();
+                    });
+                });
+            })
+        });
+
+        it('should compute median, rate and histogram', function (done) {
+            var ops = [{op: 'percentile', p: 50}, {op: 'rate'}, {op: 'histogram', buckets: 4}];
+
+            column.compute([range], ops, function (err, results) {
+                test.must(err).be.equal(null);
+                test.should(results.length).eql(3);
+
+                test.should(results[0]).eql(20);
+                test.should(results[1]).eql(10);
+                test.should(results[2].min).eql(0);
+                test.should(results[2].max).eql(40);
+                test.should(results[2].counts).eql([1, 1, 1, 2]);
+                done();
+            });
+        });
+    }); // compute
+
     describe('aggregations', function () {
         var ts = null
         var column = null
@@ -396,5 +443,29 @@ describe('Timeseries - Int64', function () {
                 done();
             });
         });
+
+        it('should return columnar first, last and sum of int64 points', function (done) {
+            var aggrs = [
+                qdb.Aggregation(qdb.AggFirst, range),
+                qdb.Aggregation(qdb.AggLast, range),
+                qdb.Aggregation(qdb.AggSum, range)
+            ];
+
+            column.aggregateColumnar(aggrs, function (err, results) {
+                test.should(err).be.equal(null);
+                test.must(results.values).be.an.instanceof(BigInt64Array);
+                test.must(results.counts).be.an.instanceof(Float64Array);
+                test.must(results.timestamps).be.an.instanceof(BigInt64Array);
+                test.should(results.values.length).eql(3);
+
+                test.should(results.values[2]).eql(15n);
+                test.should(results.counts[2]).eql(5);
+
+                var first = insertedPoints[3].timestamp;
+                test.should(results.timestamps[0]).eql(BigInt(first.seconds) * 1000000000n + BigInt(first.nanoseconds));
+
+                done();
+            });
+        });
     }); //aggregations
 });
\ No newline at end of file
@@ -0,0 +1,183 @@
+var test = require('unit.js');
+var qdb = require('..');
+var config = require('./config')
+
+var insecureCluster = new qdb.Cluster(config.insecure_cluster_uri);
+
+describe('Timeseries - Symbol', function () {
+
+    before('connect', function (done) {
+        insecureCluster.connect(done, done);
+    });
+
+    describe('column info', function () {
+        var col_info
+        before('init', function () {
+            col_info = qdb.SymbolColumnInfo('col', 'my_symtable');
+        });
+
+        it('should have name property', function () {
+            test.object(col_info).hasProperty('name')
+            test.must(col_info.name).be.a.string();
+            test.must(col_info.name).be.equal('col');
+        });
+
+        it('should have type property', function () {
+            test.object(col_info).hasProperty('type')
+            test.must(col_info.type).be.a.number();
+            test.must(col_info.type).be.equal(qdb.TS_COLUMN_SYMBOL);
+        });
+
+        it('should have symtable property', function () {
+            test.object(col_info).hasProperty('symtable')
+            test.must(col_info.symtable).be.equal('my_symtable');
+        });
+    }); // column info
+
+    describe('ts', function () {
+        var ts = null
+        before('init', function () {
+            ts = insecureCluster.ts('ts')
+        });
+
+        it('should create symbol column', function (done) {
+            ts.remove(function (err) {
+                ts.create([qdb.SymbolColumnInfo('col', 'my_symtable')], function (err, cols) {
+                    test.must(err).be.equal(null);
+                    test.must(cols.length).be.equal(1)
+                    test.object(cols[0]).isInstanceOf(qdb.SymbolColumn);
+                    test.object(cols[0]).isInstanceOf(qdb.StringColumn);
+                    test.must(cols[0].alias()).be.equal('col');
+                    test.must(cols[0].type).be.equal(qdb.TS_COLUMN_STRING);
+                    test.must(cols[0].timeseries).be.equal(ts.alias());
+                    done();
+                });
+            });
+        });
+
+        it('should list symbol column', function (done) {
+            ts.columns(function (err, columns) {
+                test.must(err).be.equal(null);
+                test.must(columns.length).be.equal(1);
+                test.object(columns[0]).isInstanceOf(qdb.SymbolColumn);
+                test.object(columns[0]).isInstanceOf(qdb.StringColumn);
+                test.must(columns[0].type).be.equal(qdb.TS_COLUMN_STRING);
+                done();
+            });
+        });
+
+        it('should remove timeseries with symbol column', function (done) {
+            ts.remove(function (err) {
+                test.must(err).be.equal(null);
+                done();
+            });
+        });
+    }); // ts
+
+    describe('ranges', function () {
+        var ts = null
+        var column = null
+        var insertedPoints = null
+        var range = null
+
+        before('init', function (done) {
+            ts = insecureCluster.ts('ts')
+            range = qdb.TsRange(
+                qdb.Timestamp.fromDate(new Date(2049, 10, 5, 0)),
+                qdb.Timestamp.fromDate(new Date(2049, 10, 6, 0))
+            );
+
+            ts.remove(function (err) {
+                ts.create([qdb.SymbolColumnInfo('col', 'my_symtable')], function (err, cols) {
+                    test.must(err).be.equal(null);
+                    test.should(cols.length).eql(1);
+
+                    column = cols[0];
+                    test.object(column).isInstanceOf(qdb.SymbolColumn);
+                    done();
+                });
+            });
+        });
+
+        it('should insert symbol points', function (done) {
+            var symbols = ['AAPL', 'MSFT', 'AAPL', 'GOOG', 'MSFT', 'AAPL'];
+            insertedPoints = symbols.map(function (s, i) {
+                return qdb.StringPoint(qdb.Timestamp.fromDate(new Date(2049, 10, 5, i + 1)), Buffer.from(s, 'utf8'));
+            });
+
+            column.insert(insertedPoints, function (err) {
+                test.must(err).be.equal(null);
+                done();
+            });
+        });
+
+        it('should not insert empty symbol points', function (done) {
+            column.insert([], function (err) {
+                test.must(err).not.be.equal(null);
+                test.must(err.code).be.equal(qdb.E_INVALID_ARGUMENT);
+                done();
+            });
+        });
+
+        it('should retrieve all symbol points', function (done) {
+            column.ranges([range], function (err, points) {
+                test.must(err).be.equal(null);
+                test.array(points).is(insertedPoints);
+                done();
+            });
+        });
+
+        it('should retrieve dictionary encoded symbol points', function (done) {
+            column.rangesColumnar([range], function (err, result) {
+                test.must(err).be.equal(null);
+
+                test.must(result.timestamps).be.an.instanceof(BigInt64Array);
+                test.must(result.codes).be.an.instanceof(Uint32Array);
+                test.should(result.dictionary).eql(['AAPL', 'MSFT', 'GOOG']);
+                test.should(Array.from(result.codes)).eql([0, 1, 0, 2, 1, 0]);
+
+                for (var i = 0; i < insertedPoints.length; i++) {
+                    var ts = insertedPoints[i].timestamp;
+                    test.should(result.timestamps[i]).eql(BigInt(ts.seconds) * 1000000000n + BigInt(ts.nanoseconds));
+                }
+                done();
+            });
+        });
+
+        it('should count symbol points', function (done) {
+            column.aggregate([qdb.Aggregation(qdb.AggCount, range)], function (err, results) {
+                test.must(err).be.equal(null);
+                test.should(results.length).eql(1);
+                test.should(results[0].count).eql(insertedPoints.length);
+                done();
+            });
+        });
+
+        it('should find first and last symbol points', function (done) {
+            var aggrs = [qdb.Aggregation(qdb.AggFirst, range), qdb.Aggregation(qdb.AggLast, range)];
+
+            column.aggregate(aggrs, function (err, results) {
+                test.must(err).be.equal(null);
+                test.should(results.length).eql(2);
+                test.should(results[0].result).eql(insertedPoints[0]);
+                test.should(results[1].result).eql(insertedPoints.slice(-1)[0]);
+                done();
+            });
+        });
+
+        it('should insert symbol points with writer', function (done) {
+            var writer = column.writer();
+            var point = qdb.StringPoint(qdb.Timestamp.fromDate(new Date(2049, 10, 5, 12)), Buffer.from('AMZN', 'utf8'));
+
+            writer.insert([point], function (err) {
+                test.must(err).be.equal(null);
+
+                column.ranges([range], function (err, points) {
+                    test.must(err).be.equal(null);
+                    test.array(points).is(insertedPoints.concat([point]));
+                    done();
+                });
+            });
+        });
+    }); // ranges
+});
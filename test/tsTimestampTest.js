@@ -193,6 +193,20 @@ describe('Timeseries - Timestamp', function () {
                 done();
             });
         });
+
+        it('should insert plain object timestamp points', function (done) {
+            var date = new Date(2049, 10, 5, 4);
+            var points = [
+                { timestamp: date, value: date },
+                { timestamp: BigInt(date.getTime() + 1) * 1000000n, value: date.getTime() + 1 }
+            ];
+
+            column.insert(points, function (err) {
+                test.must(err).be.equal(null);
+
+                done();
+            });
+        });
     }); // insert
     
 